@@ -68,4 +68,12 @@
 	 */
 	#define NANVIX_CONNECTIONS_MAX NANVIX_PROC_MAX
 
+	/**
+	 * @name Limits on Reply Channels
+	 */
+	/**@{*/
+	#define NANVIX_CHANNEL_MAILBOX_MAX (NANVIX_MAILBOX_MAX/2) /**< Maximum number of cached output mailboxes. */
+	#define NANVIX_CHANNEL_PORTAL_MAX  (NANVIX_PORTAL_MAX/2)  /**< Maximum number of cached output portals.   */
+	/**@}*/
+
 #endif /* NANVIX_LIMITS_PM_H_ */
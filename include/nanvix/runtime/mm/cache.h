@@ -51,6 +51,43 @@
 	 */
 	#define RMEM_CACHE_SIZE (RMEM_CACHE_BLOCK_SIZE*RMEM_CACHE_LENGTH)
 
+	/**
+	 * @brief Number of lines in a set of the page cache.
+	 *
+	 * By default, the page cache is fully associative. It may be
+	 * overridden with either RMEM_CACHE_WAYS or __RMEM_CACHE_WAYS.
+	 */
+	#ifndef RMEM_CACHE_WAYS
+		#ifdef __RMEM_CACHE_WAYS
+		#define RMEM_CACHE_WAYS __RMEM_CACHE_WAYS
+		#else
+		#define RMEM_CACHE_WAYS RMEM_CACHE_LENGTH
+		#endif
+	#endif
+
+	/**
+	 * @brief Maximum length of the readahead window (in lines).
+	 *
+	 * It may be overridden with either RMEM_CACHE_READAHEAD_MAX or
+	 * __RMEM_CACHE_READAHEAD_MAX.
+	 */
+	#ifndef RMEM_CACHE_READAHEAD_MAX
+		#ifdef __RMEM_CACHE_READAHEAD_MAX
+		#define RMEM_CACHE_READAHEAD_MAX __RMEM_CACHE_READAHEAD_MAX
+		#else
+		#define RMEM_CACHE_READAHEAD_MAX 4
+		#endif
+	#endif
+
+	/**
+	 * @brief Number of sets in the page cache.
+	 */
+	#define RMEM_CACHE_SETS (RMEM_CACHE_LENGTH/RMEM_CACHE_WAYS)
+
+	#if ((RMEM_CACHE_LENGTH % RMEM_CACHE_WAYS) != 0)
+	#error "length of the page cache should be a multiple of its ways"
+	#endif
+
 	/**
 	 * @name Page replacement policies.
 	 */
@@ -60,6 +97,9 @@
 	#define RMEM_CACHE_LIFO   2 /**< Last In First Out   */
 	#define RMEM_CACHE_NFU    3 /**< Not Frequently Used */
 	#define RMEM_CACHE_AGING  4 /**< Aging               */
+	#define RMEM_CACHE_LRU    5 /**< Least Recently Used */
+	#define RMEM_CACHE_CLOCK  6 /**< Second Chance       */
+	#define RMEM_CACHE_ARC    7 /**< Adaptive Cache      */
 	/**@}*/
 
 	/**
@@ -81,6 +121,17 @@
 	 */
 	extern rpage_t nanvix_rcache_alloc(void);
 
+	/**
+	 * @brief Allocates many remote pages.
+	 *
+	 * @param pgnums Location to store the numbers of the pages.
+	 * @param n      Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rcache_alloc_n(rpage_t *pgnums, int n);
+
 	/**
 	 * @brief Cleans the cache..
 	 */
@@ -96,6 +147,27 @@
 	 */
 	extern int nanvix_rcache_free(rpage_t pgnum);
 
+	/**
+	 * @brief Frees many remote pages.
+	 *
+	 * @param pgnums Numbers of the target pages.
+	 * @param n      Number of pages.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rcache_free_n(const rpage_t *pgnums, int n);
+
+	/**
+	 * @brief Clones a remote page.
+	 *
+	 * @param pgnum Number of the source page.
+	 *
+	 * @returns Upon successful completion, the number of the clone is
+	 * returned. Upon failure, @p RMEM_NULL is returned instead.
+	 */
+	extern rpage_t nanvix_rcache_clone(rpage_t pgnum);
+
 	/**
 	 * @brief Gets remote page.
 	 *
@@ -107,9 +179,26 @@
 	 */
 	extern void *nanvix_rcache_get(rpage_t pgnum);
 
+	/**
+	 * @brief Gets remote page without reading ahead.
+	 *
+	 * Pages that are mapped in place should be got this way, since
+	 * lines that are read ahead evict others behind their mappings.
+	 *
+	 * @param pgnum Number of the target page.
+	 *
+	 * @returns Upon successful completion, a pointer to a local
+	 * mapping of the remote page is returned. Upon failure, a @p
+	 * NULL pointer is returned instead.
+	 */
+	extern void *nanvix_rcache_get_noreadahead(rpage_t pgnum);
+
 	/**
 	 * @brief Puts remote page.
 	 *
+	 * The page is assumed to be modified, thus it is written back to
+	 * remote memory when evicted from the cache.
+	 *
 	 * @param pgnum Number of the target page.
 	 *
 	 * @returns Upon successful completion, zero is returned. Upon failure a
@@ -117,6 +206,42 @@
 	 */
 	extern int nanvix_rcache_put(rpage_t pgnum, int strike);
 
+	/**
+	 * @brief Marks a cached remote page as modified.
+	 *
+	 * @param pgnum Number of the target page.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure a negative error code is returned instead.
+	 */
+	extern int nanvix_rcache_mark_dirty(rpage_t pgnum);
+
+	/**
+	 * @brief Reads a byte range of a remote page.
+	 *
+	 * @param pgnum  Number of the target page.
+	 * @param buf    Target buffer.
+	 * @param offset Offset within the target page.
+	 * @param n      Number of bytes to read.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rcache_read(rpage_t pgnum, void *buf, size_t offset, size_t n);
+
+	/**
+	 * @brief Writes a byte range of a remote page.
+	 *
+	 * @param pgnum  Number of the target page.
+	 * @param buf    Source buffer.
+	 * @param offset Offset within the target page.
+	 * @param n      Number of bytes to write.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * is returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rcache_write(rpage_t pgnum, const void *buf, size_t offset, size_t n);
+
 	/**
 	 * @brief Flushes changes on a remote page.
 	 *
@@ -141,6 +266,22 @@
 	 */
 	extern int nanvix_rcache_select_write(int num);
 
+	/**
+	 * @brief Selects the maximum length of the readahead window.
+	 *
+	 * @param nlines Maximum number of lines to read ahead (zero
+	 * disables readahead).
+	 */
+	extern int nanvix_rcache_select_readahead(int nlines);
+
+	/**
+	 * @brief Gets statistics of the page cache.
+	 *
+	 * @param nhits   Store location for the number of hits.
+	 * @param nmisses Store location for the number of misses.
+	 */
+	extern void nanvix_rcache_stats(unsigned *nhits, unsigned *nmisses);
+
 	/**
 	 * @brief Invalidates a lone of the page cache.
 	 *
@@ -61,6 +61,22 @@
 	 */
 	extern int nanvix_vmem_free(void *ptr);
 
+	/**
+	 * @brief Clones remote memory.
+	 *
+	 * Blocks that span the target area are cloned in copy-on-write
+	 * fashion, thus the contents of the clone are only copied when
+	 * they are written.
+	 *
+	 * @param ptr Target remote memory area.
+	 * @param n   Number of bytes to clone.
+	 *
+	 * @returns Upon successful completion, a pointer to the clone of
+	 * the target remote memory area is returned. Upon failure, a null
+	 * pointer is returned instead.
+	 */
+	extern void *nanvix_vmem_clone(const void *ptr, size_t n);
+
 	/**
 	 * @brief Reads data from remote memory.
 	 *
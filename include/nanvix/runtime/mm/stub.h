@@ -33,6 +33,9 @@
 
 	#include <nanvix/servers/rmem.h>
 
+	/* Forward definitions. */
+	struct rmem_stats;
+
 	/**
 	 * @brief Allocates a remote memory block.
 	 *
@@ -52,6 +55,51 @@
 	 */
 	extern int nanvix_rmem_free(rpage_t blknum);
 
+	/**
+	 * @brief Allocates many remote memory blocks.
+	 *
+	 * @param blknums Location to store the numbers of the blocks.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead, and no
+	 * block is allocated.
+	 */
+	extern int nanvix_rmem_alloc_n(rpage_t *blknums, int n);
+
+	/**
+	 * @brief Frees many remote memory blocks.
+	 *
+	 * @param blknums Numbers of the target blocks.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_free_n(const rpage_t *blknums, int n);
+
+	/**
+	 * @brief Frees all remote memory blocks of the calling process.
+	 *
+	 * @returns Upon successful completion, the number of blocks that
+	 * were released is returned. Upon failure, a negative error code
+	 * is returned instead.
+	 */
+	extern int nanvix_rmem_free_all(void);
+
+	/**
+	 * @brief Clones a block of the remote memory.
+	 *
+	 * The clone shares the contents of the source block until either
+	 * of them is written.
+	 *
+	 * @param blknum Number of the source block.
+	 *
+	 * @returns Upon successful completion, the number of the clone is
+	 * returned. Upon failure, @p RMEM_NULL is returned instead.
+	 */
+	extern rpage_t nanvix_rmem_clone(rpage_t blknum);
+
 	/**
 	 * @brief Reads data from the remote memory.
 	 *
@@ -74,6 +122,299 @@
 	 */
 	extern size_t nanvix_rmem_write(rpage_t blknum, const void *buf);
 
+	/**
+	 * @brief Posts a write to the remote memory.
+	 *
+	 * The write is not waited for. Errors are reported by the next
+	 * call to nanvix_rmem_fence().
+	 *
+	 * @param blknum Number of the target block.
+	 * @param buf    Location where the data should be read from.
+	 *
+	 * @returns Upon successful completion, the number of bytes posted
+	 * is returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rmem_write_posted(rpage_t blknum, const void *buf);
+
+	/**
+	 * @brief Reads a byte range of a block from the remote memory.
+	 *
+	 * @param blknum Number of the target block.
+	 * @param buf    Location where the data should be written to.
+	 * @param offset Offset within the target block.
+	 * @param n      Number of bytes to read.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rmem_read_partial(rpage_t blknum, void *buf, size_t offset, size_t n);
+
+	/**
+	 * @brief Writes a byte range of a block to the remote memory.
+	 *
+	 * @param blknum Number of the target block.
+	 * @param buf    Location where the data should be read from.
+	 * @param offset Offset within the target block.
+	 * @param n      Number of bytes to write.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * is returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rmem_write_partial(rpage_t blknum, const void *buf, size_t offset, size_t n);
+
+	/**
+	 * @brief Reads many blocks from the remote memory.
+	 *
+	 * Blocks that live in the same server are transferred in batches
+	 * of up to @p RMEM_IOV_MAX blocks, each batch in a single
+	 * round-trip.
+	 *
+	 * @param blknums Numbers of the target blocks.
+	 * @param bufs    Locations where the blocks should be written to.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, the number of bytes read is
+	 * returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rmem_readv(const rpage_t *blknums, void * const *bufs, int n);
+
+	/**
+	 * @brief Writes many blocks to the remote memory.
+	 *
+	 * Blocks that live in the same server are transferred in batches
+	 * of up to @p RMEM_IOV_MAX blocks, each batch in a single
+	 * round-trip.
+	 *
+	 * @param blknums Numbers of the target blocks.
+	 * @param bufs    Locations where the blocks should be read from.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, the number of bytes written
+	 * is returned. Upon failure, zero is returned instead.
+	 */
+	extern size_t nanvix_rmem_writev(const rpage_t *blknums, const void * const *bufs, int n);
+
+	/**
+	 * @brief Migrates a remote memory block to another server.
+	 *
+	 * The block keeps its number, which is transparently redirected to
+	 * the new location by all other operations.
+	 *
+	 * @param blknum   Number of the target block.
+	 * @param serverid ID of the target server.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_migrate(rpage_t blknum, int serverid);
+
+	/**
+	 * @brief Spreads remote memory blocks evenly across servers.
+	 *
+	 * Blocks are migrated out of servers that have fewer free blocks
+	 * into the server that has the most free blocks.
+	 *
+	 * @param blknums Numbers of the candidate blocks.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, the number of blocks that
+	 * were migrated is returned. Upon failure, a negative error code
+	 * is returned instead.
+	 */
+	extern int nanvix_rmem_rebalance(const rpage_t *blknums, int n);
+
+	/**
+	 * @brief Posts writes of many blocks to the remote memory.
+	 *
+	 * @param blknums Numbers of the target blocks.
+	 * @param bufs    Locations where the blocks should be read from.
+	 * @param n       Number of blocks.
+	 *
+	 * @returns Upon successful completion, the number of bytes posted
+	 * is returned. Upon failure, zero is returned instead.
+	 *
+	 * @see nanvix_rmem_write_posted().
+	 */
+	extern size_t nanvix_rmem_writev_posted(const rpage_t *blknums, const void * const *bufs, int n);
+
+	/**
+	 * @brief Waits for posted writes.
+	 *
+	 * Once this function returns, all writes that were posted by the
+	 * calling process were applied by remote memory servers.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, the error hit by the first posted write that failed is
+	 * returned instead.
+	 */
+	extern int nanvix_rmem_fence(void);
+
+	/**
+	 * @brief Issues a read from the remote memory.
+	 *
+	 * The read is not waited for, thus @p buf should not be touched
+	 * until the read completes.
+	 *
+	 * @param blknum Number of the target block.
+	 * @param buf    Location where the data should be written to.
+	 *
+	 * @returns Upon successful completion, the tag of the read is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 *
+	 * @see nanvix_rmem_wait(), nanvix_rmem_poll().
+	 */
+	extern int nanvix_rmem_read_async(rpage_t blknum, void *buf);
+
+	/**
+	 * @brief Issues a write to the remote memory.
+	 *
+	 * Data is sent before this function returns, but the reply of the
+	 * server is not waited for.
+	 *
+	 * @param blknum Number of the target block.
+	 * @param buf    Location where the data should be read from.
+	 *
+	 * @returns Upon successful completion, the tag of the write is
+	 * returned. Upon failure, a negative error code is returned
+	 * instead.
+	 *
+	 * @see nanvix_rmem_wait(), nanvix_rmem_poll().
+	 */
+	extern int nanvix_rmem_write_async(rpage_t blknum, const void *buf);
+
+	/**
+	 * @brief Waits for an asynchronous request.
+	 *
+	 * Once this function returns, the tag of the target request is
+	 * released.
+	 *
+	 * @param tag Tag of the target request.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_wait(int tag);
+
+	/**
+	 * @brief Checks if an asynchronous request has completed.
+	 *
+	 * This function does not block. Replies are collected whenever the
+	 * calling process waits for a reply of a remote memory server.
+	 *
+	 * @param tag Tag of the target request.
+	 *
+	 * @returns One if the target request has completed, and zero if it
+	 * has not. Upon failure, a negative error code is returned
+	 * instead.
+	 */
+	extern int nanvix_rmem_poll(int tag);
+
+	/**
+	 * @name Atomic Operations
+	 *
+	 * Atomic operations run in the remote memory server, on a 64-bit
+	 * word of a block. The word should be aligned to its size. The
+	 * previous value of the word is stored in @p old, unless it is
+	 * NULL. Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	/**@{*/
+	extern int nanvix_rmem_fetch_add(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old);
+	extern int nanvix_rmem_compare_swap(rpage_t blknum, size_t offset, uint64_t expected, uint64_t desired, uint64_t *old);
+	extern int nanvix_rmem_swap(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old);
+	extern int nanvix_rmem_fetch_or(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old);
+	/**@}*/
+
+	/**
+	 * @brief Checkpoints a remote memory server.
+	 *
+	 * Blocks that changed since they were last checkpointed are handed
+	 * over to @p sink, one at a time, along with their owners. Blocks
+	 * that were freed are handed over with @p RMEM_RECORD_FREE as
+	 * owner. Thus, the first checkpoint of a server is a full image,
+	 * and checkpoints that follow are incremental.
+	 *
+	 * @param serverid ID of the target server.
+	 * @param sink     Sink of records. It should return zero upon
+	 *                 success and a negative error code otherwise.
+	 * @param arg      Argument for @p sink.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_checkpoint(
+		int serverid,
+		int (*sink)(rpage_t blknum, rpage_t owner, const void *data, void *arg),
+		void *arg
+	);
+
+	/**
+	 * @brief Restores a remote memory server from a checkpoint.
+	 *
+	 * Records are pulled from @p source until it runs out of them.
+	 * Servers accept restores only until they allocate a block.
+	 *
+	 * @param serverid ID of the target server.
+	 * @param source   Source of records. It should return one if a
+	 *                 record was stored, zero if there are no more
+	 *                 records, and a negative error code otherwise.
+	 * @param arg      Argument for @p source.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_restore(
+		int serverid,
+		int (*source)(rpage_t *blknum, rpage_t *owner, void *data, void *arg),
+		void *arg
+	);
+
+	/**
+	 * @brief Sets the prefetch depth of the calling process.
+	 *
+	 * Once a server detects a strided access pattern, it pushes up to
+	 * @p depth blocks ahead of each read. Reads look for pushed blocks
+	 * first.
+	 *
+	 * @param depth Prefetch depth (zero disables prefetching).
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_prefetch(int depth);
+
+	/**
+	 * @brief Gets prefetch statistics of the calling process.
+	 *
+	 * @param npushed Location to store the number of pushed blocks.
+	 * @param nhits   Location to store the number of pushed blocks that were read.
+	 */
+	extern void nanvix_rmem_prefetch_stats(unsigned *npushed, unsigned *nhits);
+
+	/**
+	 * @brief Queries the geometry of a remote memory server.
+	 *
+	 * @param serverid ID of the target server.
+	 * @param blksize  Location to store the block size (in bytes).
+	 * @param nblocks  Location to store the capacity (in blocks).
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_geometry(int serverid, size_t *blksize, rpage_t *nblocks);
+
+	/**
+	 * @brief Queries statistics of a remote memory server.
+	 *
+	 * @param serverid ID of the target server.
+	 * @param out      Location to store the statistics.
+	 *
+	 * @returns Upon successful completion, zero is returned. Upon
+	 * failure, a negative error code is returned instead.
+	 */
+	extern int nanvix_rmem_stats(int serverid, struct rmem_stats *out);
+
 	/**
 	 * @brief Shutdowns aall remote memory servers.
 	 *
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SERVERS_CHANNEL_H_
+#define SERVERS_CHANNEL_H_
+
+	#include <nanvix/limits.h>
+	#include <posix/sys/types.h>
+
+	/**
+	 * @brief Initializes the table of reply channels.
+	 *
+	 * @note Servers that live in the same cluster share the same table,
+	 * thus this should be called at server startup, which is serialized
+	 * by the spawner.
+	 */
+	extern void channels_setup(void);
+
+	/**
+	 * @brief Closes all reply channels.
+	 */
+	extern void channels_cleanup(void);
+
+	/**
+	 * @brief Gets an output mailbox to a remote.
+	 *
+	 * @param remote Target remote node.
+	 * @param port   Target port in the remote node.
+	 *
+	 * @returns Upon successful completion, the ID of an output mailbox
+	 * that is exclusively owned by the caller is returned. Upon failure,
+	 * a negative error code is returned instead.
+	 */
+	extern int channel_mailbox_get(int remote, int port);
+
+	/**
+	 * @brief Releases an output mailbox.
+	 *
+	 * @param outbox ID of the target output mailbox.
+	 */
+	extern void channel_mailbox_put(int outbox);
+
+	/**
+	 * @brief Gets an output portal to a remote.
+	 *
+	 * @param remote Target remote node.
+	 * @param port   Target port in the remote node.
+	 *
+	 * @returns Upon successful completion, the ID of an output portal
+	 * that is exclusively owned by the caller is returned. Upon failure,
+	 * a negative error code is returned instead.
+	 */
+	extern int channel_portal_get(int remote, int port);
+
+	/**
+	 * @brief Releases an output portal.
+	 *
+	 * @param outportal ID of the target output portal.
+	 */
+	extern void channel_portal_put(int outportal);
+
+#endif /* SERVERS_CHANNEL_H_ */
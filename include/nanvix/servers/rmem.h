@@ -27,8 +27,12 @@
 
 #ifdef __NEED_RMEM_SERVER
 
+	/* Must come first. */
+	#define __NEED_LIMITS_PM
+
 	#include <nanvix/types/mm/rmem.h>
 	#include <nanvix/servers/message.h>
+	#include <nanvix/limits/pm.h>
 	#include <nanvix/config.h>
 	#include <posix/stdint.h>
 	#include <posix/stddef.h>
@@ -56,9 +60,24 @@
 	#define RMEM_SIZE (32*1024*1024)
 
 	/**
-	 * @brief Number of remote memory blocks.
+	 * @brief Overcommit factor of remote memory.
+	 *
+	 * With the compressed tier, a server holds more blocks than it has
+	 * physical memory for, by compressing blocks that are cold.
+	 */
+	#ifdef __RMEM_USES_COMPRESSION
+	#define RMEM_OVERCOMMIT 4
+	#else
+	#define RMEM_OVERCOMMIT 1
+	#endif
+
+	/**
+	 * @brief Maximum number of remote memory blocks in a server.
+	 *
+	 * The actual capacity of a server is advertised to clients upon
+	 * connection, through an @p RMEM_INFO request.
 	 */
-	#define RMEM_NUM_BLOCKS (RMEM_SIZE/RMEM_BLOCK_SIZE)
+	#define RMEM_NUM_BLOCKS (RMEM_OVERCOMMIT*(RMEM_SIZE/RMEM_BLOCK_SIZE))
 
 	/**
 	 * @brief Size of payload for RMem messages.
@@ -67,6 +86,26 @@
 	#define RMEM_PAYLOAD_SIZE 64
 	#endif
 
+	/**
+	 * @brief Maximum number of write chunks in flight.
+	 *
+	 * Servers acknowledge every half window of chunks, thus it should
+	 * be even.
+	 */
+	#ifdef __RMEM_USES_MAILBOX
+	#define RMEM_WINDOW_LENGTH 8
+	#endif
+
+	/**
+	 * @brief Maximum number of blocks in a vectored operation.
+	 */
+	#define RMEM_IOV_MAX 8
+
+	/**
+	 * @brief Maximum number of blocks that are pushed ahead of a read.
+	 */
+	#define RMEM_PREFETCH_MAX (RMEM_IOV_MAX - 1)
+
 	/**
 	 * @name Shifts for remote addresses.
 	 */
@@ -120,12 +159,74 @@
 	 * @brief Operations on remote memory.
 	 */
 	/**@{*/
-	#define RMEM_EXIT    0 /**< Exit        */
-	#define RMEM_READ    1 /**< Read        */
-	#define RMEM_WRITE   2 /**< Write       */
-	#define RMEM_ALLOC   3 /**< Alloc       */
-	#define RMEM_MEMFREE 4 /**< Free        */
-	#define RMEM_ACK     5 /**< Acknowledge */
+	#define RMEM_EXIT           0 /**< Exit           */
+	#define RMEM_READ           1 /**< Read           */
+	#define RMEM_WRITE          2 /**< Write          */
+	#define RMEM_ALLOC          3 /**< Alloc          */
+	#define RMEM_MEMFREE        4 /**< Free           */
+	#define RMEM_ACK            5 /**< Acknowledge    */
+	#define RMEM_READV          6 /**< Vectored Read  */
+	#define RMEM_WRITEV         7 /**< Vectored Write */
+	#define RMEM_ALLOC_N        8 /**< Alloc Many     */
+	#define RMEM_FREE_N         9 /**< Free Many      */
+	#define RMEM_READ_PARTIAL  10 /**< Partial Read   */
+	#define RMEM_WRITE_PARTIAL 11 /**< Partial Write  */
+	#define RMEM_CLONE         12 /**< Clone          */
+	#define RMEM_STATS         13 /**< Statistics     */
+	#define RMEM_FREE_ALL      14 /**< Free All       */
+	#define RMEM_INFO          15 /**< Geometry       */
+	#define RMEM_PREFETCH      16 /**< Prefetch       */
+	#define RMEM_MIGRATE       17 /**< Migrate        */
+	#define RMEM_FENCE         18 /**< Fence          */
+	#define RMEM_ATOMIC_ADD    19 /**< Atomic Add     */
+	#define RMEM_ATOMIC_CAS    20 /**< Atomic CAS     */
+	#define RMEM_ATOMIC_SWAP   21 /**< Atomic Swap    */
+	#define RMEM_ATOMIC_OR     22 /**< Atomic Or      */
+	#define RMEM_CHECKPOINT    23 /**< Checkpoint     */
+	#define RMEM_RESTORE       24 /**< Restore        */
+	/**@}*/
+
+	/**
+	 * @name Flags of messages
+	 */
+	/**@{*/
+	#define RMEM_FLAG_ZERO   (1 << 0) /**< Block is all zeros.        */
+	#define RMEM_FLAG_ACK    (1 << 1) /**< Chunk is replied to.       */
+	#define RMEM_FLAG_POSTED (1 << 2) /**< Write is never replied to. */
+	/**@}*/
+
+	/**
+	 * @brief Tag of synchronous requests.
+	 *
+	 * Replies and acknowledges carry the tag of the request that they
+	 * answer. Asynchronous requests are tagged with non-null tags.
+	 */
+	#define RMEM_TAG_NONE 0
+
+	/**
+	 * @name Extents
+	 *
+	 * Extents of blocks are encoded in the list of block numbers of a
+	 * message as pairs of first block and number of blocks.
+	 */
+	/**@{*/
+	#define RMEM_EXTENTS_MAX          (RMEM_IOV_MAX/2)             /**< Maximum number of extents.    */
+	#define RMEM_EXTENT_START(msg, i) ((msg)->blknums[2*(i)])     /**< First block of an extent.     */
+	#define RMEM_EXTENT_COUNT(msg, i) ((msg)->blknums[2*(i) + 1]) /**< Number of blocks of an extent. */
+	/**@}*/
+
+	/**
+	 * @name Checkpoint Records
+	 *
+	 * Records of a checkpoint are encoded in the list of block numbers
+	 * of a message as pairs of block number and owner. The data of
+	 * each record is transferred through the portal, in order.
+	 */
+	/**@{*/
+	#define RMEM_RECORDS_MAX          (RMEM_IOV_MAX/2)             /**< Maximum number of records. */
+	#define RMEM_RECORD_BLOCK(msg, i) ((msg)->blknums[2*(i)])     /**< Block of a record.         */
+	#define RMEM_RECORD_OWNER(msg, i) ((msg)->blknums[2*(i) + 1]) /**< Owner of a record.         */
+	#define RMEM_RECORD_FREE          ((rpage_t) -1)               /**< Owner of a freed block.    */
 	/**@}*/
 
 	/**
@@ -133,13 +234,78 @@
 	 */
 	struct rmem_message
 	{
-		message_header header; /**< Message header. */
-		rpage_t blknum;        /**< Block number.   */
-		int errcode;           /**< Error code.     */
+		message_header header; /**< Message header.    */
+		rpage_t blknum;        /**< Block number.      */
+		int errcode;           /**< Error code.        */
+		int nblocks;           /**< Number of blocks.  */
+		uint32_t offset;       /**< Read/Write offset. */
+		uint32_t size;         /**< Read/Write size.   */
+		uint32_t flags;        /**< Flags.             */
+		uint32_t nfree;        /**< Free blocks.       */
+		uint32_t tag;          /**< Request tag.       */
+
+		/**
+		 * @brief Operation-specific arguments.
+		 */
+		union
+		{
+			rpage_t blknums[RMEM_IOV_MAX];   /**< Block numbers / extents. */
+
+			/**
+			 * @brief Operands of atomic operations.
+			 */
+			struct
+			{
+				uint64_t value;    /**< Operand / previous value. */
+				uint64_t expected; /**< Expected value (CAS).     */
+			} atomic;
+
 		#ifdef __RMEM_USES_MAILBOX
-		char payload[RMEM_PAYLOAD_SIZE]; /**< Payload.           */
-		size_t offset;                   /**< Read/Write offset. */
+			char payload[RMEM_PAYLOAD_SIZE]; /**< Payload.                 */
 		#endif
+		};
+	};
+
+	/**
+	 * @name Statistics
+	 */
+	/**@{*/
+	#define RMEM_STATS_OPCODES 32              /**< Number of opcodes that are tracked.             */
+	#define RMEM_STATS_BUCKETS 32              /**< Number of buckets of latency histograms.        */
+	#define RMEM_STATS_DEPTHS  16              /**< Number of buckets of the queue depth histogram. */
+	#define RMEM_STATS_OWNERS  NANVIX_PROC_MAX /**< Maximum number of owners that are tracked.      */
+	/**@}*/
+
+	/**
+	 * @brief Remote memory server statistics.
+	 *
+	 * Bucket @p i of a latency histogram counts requests that took
+	 * between 2^i and 2^(i+1) clock cycles to be handled. Bucket @p i
+	 * of the queue depth histogram counts requests that found @p i
+	 * requests ahead of them, when the server runs worker threads.
+	 */
+	struct rmem_stats
+	{
+		uint64_t uptime;                                            /**< Uptime (in cycles).   */
+		uint64_t nbytes_in;                                         /**< Bytes written.        */
+		uint64_t nbytes_out;                                        /**< Bytes read.           */
+		uint64_t times[RMEM_STATS_OPCODES];                         /**< Time per opcode.      */
+		uint32_t latencies[RMEM_STATS_OPCODES][RMEM_STATS_BUCKETS]; /**< Latency histograms.   */
+		uint32_t depths[RMEM_STATS_DEPTHS];                         /**< Queue depth samples.  */
+		uint32_t nblocks;                                           /**< Blocks allocated.     */
+
+		/**
+		 * @brief Per-owner counters.
+		 */
+		struct
+		{
+			int nodenum;      /**< Owner (negative if unused). */
+			uint32_t nreads;  /**< Read requests.              */
+			uint32_t nwrites; /**< Write requests.             */
+			uint32_t nallocs; /**< Allocation requests.        */
+			uint32_t nfrees;  /**< Free requests.              */
+			uint64_t nbytes;  /**< Bytes moved.                */
+		} owners[RMEM_STATS_OWNERS];
 	};
 
 	/**
@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#define __NEED_MM_RMEM_STUB
+
 #include <nanvix/runtime/runtime.h>
 #include <nanvix/runtime/stdikc.h>
 #include <nanvix/ulib.h>
@@ -57,6 +59,11 @@ int __main2(int argc, const char *argv[])
 		__main3(argc, argv);
 
 		uassert(name_unlink(pname) == 0);
+
+		/* Release remote memory before servers shut down. */
+		if (nanvix_rmem_free_all() < 0)
+			uprintf("[nanvix][rmem] cannot release remote memory blocks");
+
 		uassert(stdsync_fence() == 0);
 
 		nanvix_shutdown();
@@ -78,6 +78,12 @@ struct cache_slot
 	char pages[RMEM_BLOCK_SIZE] ALIGN(PAGE_SIZE);
 	AGE_TYPE age;
 	int ref_count;
+	int referenced;
+	int dirty;
+	int tag;
+	int prefetched;
+	int stream;
+	unsigned stream_birth;
 };
 
 /*
@@ -85,6 +91,155 @@ struct cache_slot
  */
 static struct cache_slot cache_lines[RMEM_CACHE_SIZE];
 
+/**
+ * @brief Minimum length of the page index.
+ *
+ * The index holds cached pages and ghosts of evicted lines, and it is
+ * kept at most half full, so that probe sequences are short.
+ */
+#define RMEM_CACHE_INDEX_MIN (2*(RMEM_CACHE_SIZE + RMEM_CACHE_LENGTH))
+
+/**
+ * @brief Length of the page index (log 2).
+ *
+ * The length is rounded up to a power of two, so that home positions
+ * are taken from the high bits of a Fibonacci hash.
+ */
+#define RMEM_CACHE_INDEX_LENGTH_LOG2 ( \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  4)) ?  4 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  5)) ?  5 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  6)) ?  6 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  7)) ?  7 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  8)) ?  8 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 <<  9)) ?  9 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 10)) ? 10 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 11)) ? 11 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 12)) ? 12 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 13)) ? 13 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 14)) ? 14 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 15)) ? 15 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 16)) ? 16 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 17)) ? 17 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 18)) ? 18 : \
+	(RMEM_CACHE_INDEX_MIN <= (1 << 19)) ? 19 : \
+	20)
+
+/**
+ * @brief Length of the page index.
+ */
+#define RMEM_CACHE_INDEX_LENGTH (1 << RMEM_CACHE_INDEX_LENGTH_LOG2)
+
+#if (RMEM_CACHE_INDEX_LENGTH < RMEM_CACHE_INDEX_MIN)
+	#error "page index of the page cache is too large"
+#endif
+
+/**
+ * @brief Page index.
+ *
+ * Open-addressed hash table with linear probing that maps numbers of
+ * pages to slots of the page cache. Ghosts of evicted lines are
+ * mapped to negative slots.
+ */
+static struct
+{
+	rpage_t pgnum; /**< Page number (null if unused). */
+	int slot;      /**< Cache slot.                   */
+} cache_index[RMEM_CACHE_INDEX_LENGTH];
+
+/**
+ * @name Replacement lists.
+ *
+ * Each set of the page cache has its own lists, which are kept from
+ * the most recently inserted node (head) to the least recently
+ * inserted one (tail). The LRU and CLOCK policies keep resident lines
+ * in T1 only.
+ */
+/**@{*/
+#define RMEM_CACHE_LIST_FREE  0 /**< Free lines.                 */
+#define RMEM_CACHE_LIST_T1    1 /**< Lines referenced once.      */
+#define RMEM_CACHE_LIST_T2    2 /**< Lines referenced often.     */
+#define RMEM_CACHE_LIST_B1    3 /**< Ghosts of lines from T1.    */
+#define RMEM_CACHE_LIST_B2    4 /**< Ghosts of lines from T2.    */
+#define RMEM_CACHE_LIST_GHOST 5 /**< Unused ghosts.              */
+#define RMEM_CACHE_LIST_NUM   6 /**< Number of replacement lists. */
+/**@}*/
+
+/**
+ * @brief Number of list nodes.
+ *
+ * Node @p i stands for line @p i, and node @p RMEM_CACHE_LENGTH + @p i
+ * stands for ghost @p i. Ghost @p i belongs to the same set as line
+ * @p i does.
+ */
+#define RMEM_CACHE_NODES (2*RMEM_CACHE_LENGTH)
+
+/**
+ * @brief Gets the set of a list node.
+ */
+#define RMEM_CACHE_NODE_SET(node) (((node) % RMEM_CACHE_LENGTH)/RMEM_CACHE_WAYS)
+
+/**
+ * @brief List nodes.
+ */
+static struct
+{
+	int prev; /**< Previous node (negative if none). */
+	int next; /**< Next node (negative if none).     */
+	int list; /**< List (negative if none).          */
+} cache_nodes[RMEM_CACHE_NODES];
+
+/**
+ * @brief Replacement lists.
+ */
+static struct
+{
+	int head;   /**< Most recently inserted node.  */
+	int tail;   /**< Least recently inserted node. */
+	int length; /**< Number of nodes.              */
+} cache_lists[RMEM_CACHE_SETS][RMEM_CACHE_LIST_NUM];
+
+/**
+ * @brief Pages of ghosts.
+ */
+static rpage_t cache_ghosts[RMEM_CACHE_LENGTH];
+
+/**
+ * @brief Clock hands (one per set).
+ */
+static int cache_hand[RMEM_CACHE_SETS];
+
+/**
+ * @brief Target lengths of T1 in the ARC policy (one per set).
+ */
+static int arc_target[RMEM_CACHE_SETS];
+
+/**
+ * @brief Line that may not be evicted (negative if none).
+ */
+static int cache_pinned = -1;
+
+/**
+ * @brief Number of tracked access streams.
+ */
+#define RMEM_CACHE_STREAMS_MAX 4
+
+/**
+ * @brief Access streams.
+ */
+static struct
+{
+	rpage_t next;   /**< Page expected next.          */
+	rpage_t ahead;  /**< First page not read ahead.   */
+	int window;     /**< Readahead window (in lines). */
+	unsigned age;   /**< Time of last access.         */
+	unsigned birth; /**< Time of creation.            */
+} cache_streams[RMEM_CACHE_STREAMS_MAX];
+
+/**
+ * @brief Maximum length of the readahead window (in lines).
+ */
+static int readahead_max = RMEM_CACHE_READAHEAD_MAX;
+
 /**
  * @brief Discrete cache time.
  */
@@ -173,275 +328,739 @@ int nanvix_rcache_line_inval(int lineno)
 }
 
 /*============================================================================*
- * nanvix_rcache_clean()                                                      *
+ * Page Index                                                                 *
  *============================================================================*/
 
 /**
- * @brief Cleans the cache.
+ * @brief Hashes a page number.
  *
- * @bug FIXME: this funciton should not exist.
+ * @param pgnum Number of the target page.
+ *
+ * @returns The home position of the target page in the page index.
  */
-void nanvix_rcache_clean(void)
+static inline int nanvix_rcache_index_hash(rpage_t pgnum)
 {
-	for (int i = 0; i < RMEM_CACHE_LENGTH*RMEM_CACHE_BLOCK_SIZE; i++)
-	{
-		cache_lines[i].pgnum = RMEM_NULL;
-		cache_lines[i].age = 0;
-	}
+	/* Fibonacci hashing. */
+	return ((int) (((uint32_t) pgnum*2654435761U) >> (32 - RMEM_CACHE_INDEX_LENGTH_LOG2)));
 }
 
-/*============================================================================*
- * nanvix_rcache_page_search()                                                *
- *============================================================================*/
-
 /**
- * @brief Searches for a page in the cache.
+ * @brief Searches for a page in the page index.
  *
  * @param pgnum Number of the target page.
  *
- * @returns Upon successful completion, the page index is
- * returned. Upon failure a negative error code is returned instead.
+ * @returns If the target page is found, its position in the page
+ * index is returned. Otherwise, a negative number is returned
+ * instead.
  */
-static struct tuple nanvix_rcache_page_search(rpage_t pgnum)
+static int nanvix_rcache_index_find(rpage_t pgnum)
 {
-	cache_time++;
-	int pgnum_block;
-	struct tuple indexes;
+	int i = nanvix_rcache_index_hash(pgnum);
 
-	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
+	while (cache_index[i].pgnum != RMEM_NULL)
 	{
-		pgnum_block = (int)(pgnum) - (int)(cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum);
-		if (pgnum_block >= 0 && pgnum_block < RMEM_CACHE_BLOCK_SIZE && cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum != RMEM_NULL)
-		{
-			for (int j = 0; j < RMEM_CACHE_BLOCK_SIZE; j++)
-			{
-				if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE+j].pgnum == pgnum)
-				{
-					indexes.slot_idx = i*RMEM_CACHE_BLOCK_SIZE;
-					indexes.block_idx = j;
-					indexes.error = 0;
-					return indexes;
-				}
-			}
-		}
+		if (cache_index[i].pgnum == pgnum)
+			return (i);
+
+		i = (i + 1) % RMEM_CACHE_INDEX_LENGTH;
 	}
 
-	indexes.error = (-EFAULT);
-	return indexes;
+	return (-1);
 }
 
-static int nanvix_rcache_page_search_slot(rpage_t pgnum)
+/**
+ * @brief Inserts a page in the page index.
+ *
+ * If the target page is already indexed, its slot is updated.
+ *
+ * @param pgnum Number of the target page.
+ * @param slot  Cache slot of the target page.
+ */
+static void nanvix_rcache_index_insert(rpage_t pgnum, int slot)
 {
-	cache_time++;
-	int pgnum_block;
+	int i = nanvix_rcache_index_hash(pgnum);
 
-	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
-	{ pgnum_block = (int)(pgnum) - (int)(cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum);
-		if (pgnum_block >= 0 && pgnum_block < RMEM_CACHE_BLOCK_SIZE && cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum != RMEM_NULL)
-		{
-			for (int j = 0; j < RMEM_CACHE_BLOCK_SIZE; j++)
-			{
-				if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE+j].pgnum == pgnum)
-					return (i*RMEM_CACHE_BLOCK_SIZE);
-			}
-		}
-	}
+	while ((cache_index[i].pgnum != RMEM_NULL) && (cache_index[i].pgnum != pgnum))
+		i = (i + 1) % RMEM_CACHE_INDEX_LENGTH;
 
-	return (-EFAULT);
+	cache_index[i].pgnum = pgnum;
+	cache_index[i].slot = slot;
 }
 
-static void nanvix_rcache_aging(int idx)
+/**
+ * @brief Removes a page from the page index.
+ *
+ * The page is removed only if it is indexed at @p slot. Entries that
+ * follow in the same probe sequence are shifted back, thus no
+ * tombstones are left behind.
+ *
+ * @param pgnum Number of the target page.
+ * @param slot  Cache slot of the target page.
+ */
+static void nanvix_rcache_index_remove(rpage_t pgnum, int slot)
 {
-	AGE_TYPE temp_age = 0;
-	update_count++;
-	if (UPDATE_FREQ == update_count)
+	int i;
+	int j;
+
+	/* Page not indexed at the target slot. */
+	if (((i = nanvix_rcache_index_find(pgnum)) < 0) || (cache_index[i].slot != slot))
+		return;
+
+	j = i;
+	while (1)
 	{
-		for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
-		{
-			temp_age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age;
-			temp_age = (temp_age) >> 1;
-			if (i*RMEM_CACHE_BLOCK_SIZE == idx)
-			{
-				if (cache_lines[idx].ref_count == 1)
-				{
-					temp_age = (AGE_TYPE)1 << (sizeof(AGE_TYPE)*8-1) | temp_age;
-					cache_lines[idx].ref_count = (UPDATE_FREQ == 1 ? 1 : 0);
-				} else {
-					temp_age = (AGE_TYPE)0 << (sizeof(AGE_TYPE)*8-1) | temp_age;
-				}
-			}
-			cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age = temp_age;
-		}
-		update_count = 0;
-	} else {
-		if (cache_lines[idx].ref_count == 0)
+		int home;
+
+		cache_index[i].pgnum = RMEM_NULL;
+
+		/* Find an entry that may fill the hole. */
+		do
 		{
-			cache_lines[idx].ref_count++;
-		}
+			j = (j + 1) % RMEM_CACHE_INDEX_LENGTH;
+
+			if (cache_index[j].pgnum == RMEM_NULL)
+				return;
+
+			home = nanvix_rcache_index_hash(cache_index[j].pgnum);
+		} while ((i <= j) ? ((i < home) && (home <= j)) : ((i < home) || (home <= j)));
+
+		cache_index[i] = cache_index[j];
+		i = j;
 	}
 }
 
-/*============================================================================*
- * nanvix_rcache_age_update_nfu()                                             *
- *============================================================================*/
-
 /**
- * @brief Evicts pages from the cache based on the NFU replacement policy.
+ * @brief Looks up a page in the page index.
  *
  * @param pgnum Number of the target page.
  *
- * @returns Upon successful completion, the index of the page is
- * returned. Upon failure a negative error code is returned instead.
+ * @returns If the target page is cached, its slot is returned.
+ * Otherwise, a negative number is returned instead.
  */
-static int nanvix_rcache_age_update(rpage_t pgnum)
+static inline int nanvix_rcache_index_lookup(rpage_t pgnum)
 {
-	struct tuple idx = nanvix_rcache_page_search(pgnum);
-	int slot = idx.slot_idx;
-	int error = idx.error;
-
-	cache_time++;
-
-	if (error < 0)
-		return (-EFAULT);
+	int i;
 
-	if (cache_policy == RMEM_CACHE_NFU)
-	{
-		update_count++;
-		if (UPDATE_FREQ == update_count)
-		{
-			if (cache_lines[slot].ref_count == 1)
-			{
-				cache_lines[slot].age++;
-				cache_lines[slot].ref_count = (UPDATE_FREQ == 1 ? 1 : 0);
-			}
-			update_count = 0;
-		} else {
-			if (cache_lines[slot].ref_count == 0)
-				cache_lines[slot].ref_count++;
-		}
-	} else if (cache_policy == RMEM_CACHE_AGING) {
-		nanvix_rcache_aging(slot);
-	}
+	if ((pgnum == RMEM_NULL) || ((i = nanvix_rcache_index_find(pgnum)) < 0))
+		return (-1);
 
-	return (0);
+	return (cache_index[i].slot);
 }
 
 /*============================================================================*
- * nanvix_rcache_age_init()                                                   *
+ * Replacement Lists                                                          *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Removes a node from its replacement list.
+ *
+ * @param node Target node.
  */
-static int nanvix_rcache_age_init(rpage_t pgnum)
+static void nanvix_rcache_list_remove(int node)
 {
-	struct tuple idx = nanvix_rcache_page_search(pgnum);
-	int slot = idx.slot_idx;
-	int error = idx.error;
+	int prev = cache_nodes[node].prev;
+	int next = cache_nodes[node].next;
+	int list = cache_nodes[node].list;
+	int set = RMEM_CACHE_NODE_SET(node);
 
-	cache_time++;
+	/* Not linked. */
+	if (list < 0)
+		return;
 
-	if (error < 0)
-		return (-EFAULT);
+	if (prev >= 0)
+		cache_nodes[prev].next = next;
+	else
+		cache_lists[set][list].head = next;
 
-	if (cache_policy == RMEM_CACHE_AGING) {
-		cache_lines[slot].age = 0;
-		cache_lines[slot].ref_count = 1;
-		nanvix_rcache_aging(pgnum);
-	} else if (cache_policy == RMEM_CACHE_NFU) {
-		cache_lines[slot].age = 1;
-		cache_lines[slot].ref_count = 1;
-	} else {
-		cache_lines[slot].age = cache_time;
-	}
-	return 0;
+	if (next >= 0)
+		cache_nodes[next].prev = prev;
+	else
+		cache_lists[set][list].tail = prev;
+
+	cache_lists[set][list].length--;
+	cache_nodes[node].list = -1;
 }
-/*============================================================================*
- * msbDebruijn32()                                                            *
- *============================================================================*/
 
 /**
- * @brief Search a value for its most significant bit that is setted.
- *
- * @param v Value to be used for bit search.
+ * @brief Moves a node to the head of a replacement list.
  *
- * @returns Upon successful completion, the index for the msb setted bit is
- * returned.
+ * @param list Target list (in the set of the target node).
+ * @param node Target node.
  */
-uint32_t msbDeBruijn32( uint32_t v )
+static void nanvix_rcache_list_push(int list, int node)
 {
-    static const int MultiplyDeBruijnBitPosition[32] =
-    {
-    0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
-    8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
-    };
+	int head;
+	int set = RMEM_CACHE_NODE_SET(node);
 
-    v |= v >> 1; // first round down to one less than a power of 2
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
+	nanvix_rcache_list_remove(node);
 
-    return MultiplyDeBruijnBitPosition[( uint32_t )( v * 0x07C4ACDDU ) >> 27];
-}
+	head = cache_lists[set][list].head;
 
-/*============================================================================*
- * random_mod()                                                               *
- *============================================================================*/
+	cache_nodes[node].prev = -1;
+	cache_nodes[node].next = head;
+	cache_nodes[node].list = list;
+
+	if (head >= 0)
+		cache_nodes[head].prev = node;
+	else
+		cache_lists[set][list].tail = node;
+
+	cache_lists[set][list].head = node;
+	cache_lists[set][list].length++;
+}
 
 /**
- * @brief Generate a random number and it's mod by parameter value.
+ * @brief Gets the length of a replacement list.
  *
- * @param v Value to be used for mod operation.
+ * @param set  Target set.
+ * @param list Target list.
  *
- * @returns Upon successful completion, the mod for the random number and a
- * value is returned.
+ * @returns The number of nodes in the target list.
  */
-int random_mod(int v)
+static inline int nanvix_rcache_list_length(int set, int list)
 {
-    int random_number = urand();
-    uint32_t msb = msbDeBruijn32(v);
-    uint32_t mod_power_two = ((0x1 << msb ) - 1) & random_number;
-    while(mod_power_two > (uint32_t)v)
-        mod_power_two -= v;
-    random_number = mod_power_two;
-    return random_number;
+	return (cache_lists[set][list].length);
 }
 
-/*============================================================================*
- * nanvix_rcache_fifo()                                                       *
- *============================================================================*/
-
 /**
- * @brief Evicts pages from the cache based on the FIFO replacement policy.
+ * @brief Gets the line of a replacement list that should be evicted.
  *
- * @param pgnum Number of the target page.
+ * @param set  Target set.
+ * @param list Target list.
  *
- * @returns Upon successful completion, the index of the page is
- * returned. Upon failure a negative error code is returned instead.
+ * @returns The least recently inserted line of the target list that
+ * is not pinned. If there is no such line, a negative number is
+ * returned instead.
  */
-static int nanvix_rcache_fifo(void)
+static inline int nanvix_rcache_list_victim(int set, int list)
 {
-	int slot_idx;
-	int draw_count = 1;
-	AGE_TYPE age;
-	AGE_TYPE min_age;
+	int line = cache_lists[set][list].tail;
 
-	cache_time++;
+	if ((line >= 0) && (line == cache_pinned))
+		line = cache_nodes[line].prev;
 
-	/* Cache has space. */
-	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
-	{
-		if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum == RMEM_NULL)
+	return (line);
+}
+
+/**
+ * @brief Looks up a ghost in the page index.
+ *
+ * @param pgnum Number of the target page.
+ *
+ * @returns If the target page is the first page of a line that was
+ * recently evicted, the node of its ghost is returned. Otherwise, a
+ * negative number is returned instead.
+ */
+static int nanvix_rcache_ghost_lookup(rpage_t pgnum)
+{
+	int i;
+
+	if ((pgnum == RMEM_NULL) || ((i = nanvix_rcache_index_find(pgnum)) < 0))
+		return (-1);
+
+	if (cache_index[i].slot >= 0)
+		return (-1);
+
+	return (-(cache_index[i].slot + 1));
+}
+
+/**
+ * @brief Forgets a ghost.
+ *
+ * @param node Node of the target ghost.
+ */
+static void nanvix_rcache_ghost_drop(int node)
+{
+	nanvix_rcache_index_remove(cache_ghosts[node - RMEM_CACHE_LENGTH], -(node + 1));
+	nanvix_rcache_list_push(RMEM_CACHE_LIST_GHOST, node);
+}
+
+/**
+ * @brief Leaves a ghost for a line that is about to be evicted.
+ *
+ * @param list Target ghost list.
+ * @param line Target line.
+ */
+static void nanvix_rcache_ghost_add(int list, int line)
+{
+	int node;
+	int set = RMEM_CACHE_NODE_SET(line);
+	rpage_t pgnum = cache_lines[line*RMEM_CACHE_BLOCK_SIZE].pgnum;
+
+	/* Page is cached in some other line as well. */
+	if (nanvix_rcache_index_lookup(pgnum) != line*RMEM_CACHE_BLOCK_SIZE)
+		return;
+
+	/* Recycle the oldest ghost. */
+	if ((node = cache_lists[set][RMEM_CACHE_LIST_GHOST].tail) < 0)
+	{
+		node = (nanvix_rcache_list_length(set, RMEM_CACHE_LIST_B2) > 0) ?
+			cache_lists[set][RMEM_CACHE_LIST_B2].tail :
+			cache_lists[set][RMEM_CACHE_LIST_B1].tail;
+		nanvix_rcache_ghost_drop(node);
+	}
+
+	cache_ghosts[node - RMEM_CACHE_LENGTH] = pgnum;
+	nanvix_rcache_index_insert(pgnum, -(node + 1));
+	nanvix_rcache_list_push(list, node);
+}
+
+/**
+ * @brief Rebuilds the replacement lists.
+ *
+ * Free lines are placed in the free list, resident lines in T1 and
+ * ghosts are forgotten.
+ */
+static void nanvix_rcache_lists_reset(void)
+{
+	/* Forget ghosts. */
+	for (int i = RMEM_CACHE_LENGTH; i < RMEM_CACHE_NODES; i++)
+	{
+		if ((cache_nodes[i].list == RMEM_CACHE_LIST_B1) || (cache_nodes[i].list == RMEM_CACHE_LIST_B2))
+			nanvix_rcache_index_remove(cache_ghosts[i - RMEM_CACHE_LENGTH], -(i + 1));
+	}
+
+	for (int i = 0; i < RMEM_CACHE_SETS; i++)
+	{
+		for (int j = 0; j < RMEM_CACHE_LIST_NUM; j++)
+		{
+			cache_lists[i][j].head = -1;
+			cache_lists[i][j].tail = -1;
+			cache_lists[i][j].length = 0;
+		}
+
+		cache_hand[i] = 0;
+		arc_target[i] = 0;
+	}
+
+	for (int i = 0; i < RMEM_CACHE_NODES; i++)
+		cache_nodes[i].list = -1;
+
+	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
+	{
+		cache_lines[i*RMEM_CACHE_BLOCK_SIZE].referenced = 0;
+		nanvix_rcache_list_push(
+			(cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum == RMEM_NULL) ?
+				RMEM_CACHE_LIST_FREE : RMEM_CACHE_LIST_T1,
+			i
+		);
+	}
+
+	for (int i = RMEM_CACHE_LENGTH; i < RMEM_CACHE_NODES; i++)
+		nanvix_rcache_list_push(RMEM_CACHE_LIST_GHOST, i);
+}
+
+/**
+ * @brief Selects the set of the page cache where a line is placed.
+ *
+ * @param pgnum Number of the first page of the target line.
+ *
+ * @returns The set where the target line is placed.
+ */
+static inline int nanvix_rcache_set(rpage_t pgnum)
+{
+	/* Middle bits of a Fibonacci hash. */
+	return ((int) ((((uint32_t) pgnum*2654435761U) >> 16) % RMEM_CACHE_SETS));
+}
+
+/**
+ * @brief Waits for a slot of the page cache that is being read ahead.
+ *
+ * @param slot Target slot.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_slot_wait(int slot)
+{
+	int tag;
+
+	/* Nothing in flight. */
+	if ((tag = cache_lines[slot].tag) == 0)
+		return (0);
+
+	cache_lines[slot].tag = 0;
+
+	return (nanvix_rmem_wait(tag));
+}
+
+/**
+ * @brief Assigns a page to a slot of the page cache.
+ *
+ * @param slot  Target slot.
+ * @param pgnum Number of the target page (null to release the slot).
+ */
+static void nanvix_rcache_slot_set(int slot, rpage_t pgnum)
+{
+	/* Do not let a late transfer overwrite the slot. */
+	nanvix_rcache_slot_wait(slot);
+
+	/* Line was read ahead in vain. */
+	if (cache_lines[slot].prefetched)
+	{
+		int s = cache_lines[slot].stream;
+
+		/* Stream may have been replaced meanwhile. */
+		if (cache_streams[s].birth == cache_lines[slot].stream_birth)
+			cache_streams[s].window /= 2;
+		cache_lines[slot].prefetched = 0;
+	}
+
+	cache_lines[slot].dirty = 0;
+
+	if (cache_lines[slot].pgnum != RMEM_NULL)
+		nanvix_rcache_index_remove(cache_lines[slot].pgnum, slot);
+
+	if ((cache_lines[slot].pgnum = pgnum) != RMEM_NULL)
+		nanvix_rcache_index_insert(pgnum, slot);
+
+	/* Line released. */
+	else if ((slot % RMEM_CACHE_BLOCK_SIZE) == 0)
+		nanvix_rcache_list_push(RMEM_CACHE_LIST_FREE, slot/RMEM_CACHE_BLOCK_SIZE);
+}
+
+/*============================================================================*
+ * nanvix_rcache_clean()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Cleans the cache.
+ *
+ * @bug FIXME: this funciton should not exist.
+ */
+void nanvix_rcache_clean(void)
+{
+	for (int i = 0; i < RMEM_CACHE_LENGTH*RMEM_CACHE_BLOCK_SIZE; i++)
+	{
+		nanvix_rcache_slot_wait(i);
+		cache_lines[i].prefetched = 0;
+		cache_lines[i].pgnum = RMEM_NULL;
+		cache_lines[i].age = 0;
+		cache_lines[i].dirty = 0;
+	}
+
+	for (int i = 0; i < RMEM_CACHE_INDEX_LENGTH; i++)
+		cache_index[i].pgnum = RMEM_NULL;
+
+	for (int i = 0; i < RMEM_CACHE_STREAMS_MAX; i++)
+		cache_streams[i].next = RMEM_NULL;
+
+	nanvix_rcache_lists_reset();
+}
+
+/*============================================================================*
+ * nanvix_rcache_page_search()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a page in the cache.
+ *
+ * @param pgnum Number of the target page.
+ *
+ * @returns Upon successful completion, the page index is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static struct tuple nanvix_rcache_page_search(rpage_t pgnum)
+{
+	int slot;
+	struct tuple indexes;
+
+	cache_time++;
+
+	if ((slot = nanvix_rcache_index_lookup(pgnum)) < 0)
+	{
+		indexes.error = (-EFAULT);
+		return indexes;
+	}
+
+	indexes.slot_idx = slot - (slot % RMEM_CACHE_BLOCK_SIZE);
+	indexes.block_idx = slot % RMEM_CACHE_BLOCK_SIZE;
+	indexes.error = 0;
+
+	return indexes;
+}
+
+static void nanvix_rcache_aging(int idx)
+{
+	AGE_TYPE temp_age = 0;
+	update_count++;
+	if (UPDATE_FREQ == update_count)
+	{
+		for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
+		{
+			temp_age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age;
+			temp_age = (temp_age) >> 1;
+			if (i*RMEM_CACHE_BLOCK_SIZE == idx)
+			{
+				if (cache_lines[idx].ref_count == 1)
+				{
+					temp_age = (AGE_TYPE)1 << (sizeof(AGE_TYPE)*8-1) | temp_age;
+					cache_lines[idx].ref_count = (UPDATE_FREQ == 1 ? 1 : 0);
+				} else {
+					temp_age = (AGE_TYPE)0 << (sizeof(AGE_TYPE)*8-1) | temp_age;
+				}
+			}
+			cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age = temp_age;
+		}
+		update_count = 0;
+	} else {
+		if (cache_lines[idx].ref_count == 0)
+		{
+			cache_lines[idx].ref_count++;
+		}
+	}
+}
+
+/*============================================================================*
+ * nanvix_rcache_age_update_nfu()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Updates the age of a line on a hit.
+ *
+ * @param slot Index of the first slot of the target line.
+ */
+static void nanvix_rcache_age_update(int slot)
+{
+	cache_time++;
+
+	if (cache_policy == RMEM_CACHE_NFU)
+	{
+		update_count++;
+		if (UPDATE_FREQ == update_count)
+		{
+			if (cache_lines[slot].ref_count == 1)
+			{
+				cache_lines[slot].age++;
+				cache_lines[slot].ref_count = (UPDATE_FREQ == 1 ? 1 : 0);
+			}
+			update_count = 0;
+		} else {
+			if (cache_lines[slot].ref_count == 0)
+				cache_lines[slot].ref_count++;
+		}
+	} else if (cache_policy == RMEM_CACHE_AGING) {
+		nanvix_rcache_aging(slot);
+	} else if (cache_policy == RMEM_CACHE_LRU) {
+		nanvix_rcache_list_push(RMEM_CACHE_LIST_T1, slot/RMEM_CACHE_BLOCK_SIZE);
+	} else if (cache_policy == RMEM_CACHE_CLOCK) {
+		cache_lines[slot].referenced = 1;
+	} else if (cache_policy == RMEM_CACHE_ARC) {
+		nanvix_rcache_list_push(RMEM_CACHE_LIST_T2, slot/RMEM_CACHE_BLOCK_SIZE);
+	}
+}
+
+/*============================================================================*
+ * nanvix_rcache_age_init()                                                   *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+static int nanvix_rcache_age_init(rpage_t pgnum)
+{
+	struct tuple idx = nanvix_rcache_page_search(pgnum);
+	int slot = idx.slot_idx;
+	int error = idx.error;
+
+	cache_time++;
+
+	if (error < 0)
+		return (-EFAULT);
+
+	if (cache_policy == RMEM_CACHE_AGING) {
+		cache_lines[slot].age = 0;
+		cache_lines[slot].ref_count = 1;
+		nanvix_rcache_aging(pgnum);
+	} else if (cache_policy == RMEM_CACHE_NFU) {
+		cache_lines[slot].age = 1;
+		cache_lines[slot].ref_count = 1;
+	} else {
+		cache_lines[slot].age = cache_time;
+	}
+	return 0;
+}
+/*============================================================================*
+ * msbDebruijn32()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Search a value for its most significant bit that is setted.
+ *
+ * @param v Value to be used for bit search.
+ *
+ * @returns Upon successful completion, the index for the msb setted bit is
+ * returned.
+ */
+uint32_t msbDeBruijn32( uint32_t v )
+{
+    static const int MultiplyDeBruijnBitPosition[32] =
+    {
+    0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+    8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+    };
+
+    v |= v >> 1; // first round down to one less than a power of 2
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+
+    return MultiplyDeBruijnBitPosition[( uint32_t )( v * 0x07C4ACDDU ) >> 27];
+}
+
+/*============================================================================*
+ * random_mod()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Generate a random number and it's mod by parameter value.
+ *
+ * @param v Value to be used for mod operation.
+ *
+ * @returns Upon successful completion, the mod for the random number and a
+ * value is returned.
+ */
+int random_mod(int v)
+{
+    int random_number = urand();
+    uint32_t msb = msbDeBruijn32(v);
+    uint32_t mod_power_two = ((0x1 << msb ) - 1) & random_number;
+    while(mod_power_two > (uint32_t)v)
+        mod_power_two -= v;
+    random_number = mod_power_two;
+    return random_number;
+}
+
+/*============================================================================*
+ * nanvix_rcache_line_load()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Loads a line of the page cache.
+ *
+ * All pages of the line are fetched with a single vectored read.
+ *
+ * @param slot_idx Index of the first slot of the target line.
+ * @param pgnum    Number of the first page of the line.
+ */
+static void nanvix_rcache_line_load(int slot_idx, rpage_t pgnum)
+{
+	int n = 0;
+	void *bufs[RMEM_CACHE_BLOCK_SIZE];
+	rpage_t pgnums[RMEM_CACHE_BLOCK_SIZE];
+
+	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
+	{
+		nanvix_rcache_slot_set(slot_idx + i, (rpage_t)(pgnum + i));
+
+		/* Skip pages that lie beyond remote memory. */
+		if (RMEM_BLOCK_NUM(pgnum + i) >= RMEM_NUM_BLOCKS)
+			continue;
+
+		pgnums[n] = (rpage_t)(pgnum + i);
+		bufs[n++] = cache_lines[slot_idx + i].pages;
+	}
+
+	/*
+	 * Pages that follow the target one may not be allocated, thus
+	 * errors on the transfer are tolerated.
+	 */
+	nanvix_rmem_readv(pgnums, bufs, n);
+}
+
+/*============================================================================*
+ * nanvix_rcache_line_writeback()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Writes back a line of the page cache.
+ *
+ * Dirty pages of the line are posted with a single vectored write,
+ * which is not waited for. Errors are reported by the next flush.
+ * Clean pages are dropped.
+ *
+ * @param slot_idx Index of the first slot of the target line.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_line_writeback(int slot_idx)
+{
+	int n = 0;
+	const void *bufs[RMEM_CACHE_BLOCK_SIZE];
+	rpage_t pgnums[RMEM_CACHE_BLOCK_SIZE];
+
+	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
+	{
+		rpage_t pgnum = cache_lines[slot_idx + i].pgnum;
+
+		/* Clean page. */
+		if (!cache_lines[slot_idx + i].dirty)
+			continue;
+
+		/* Invalid page number. */
+		if ((pgnum == RMEM_NULL) || (RMEM_BLOCK_NUM(pgnum) >= RMEM_NUM_BLOCKS))
+			return (-EFAULT);
+
+		pgnums[n] = pgnum;
+		bufs[n++] = cache_lines[slot_idx + i].pages;
+	}
+
+	/* Nothing to write back. */
+	if (n == 0)
+		return (0);
+
+	/* Errors on the transfer are reported by the next flush. */
+	nanvix_rmem_writev_posted(pgnums, bufs, n);
+
+	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
+		cache_lines[slot_idx + i].dirty = 0;
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_rcache_fifo()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Evicts pages from the cache based on the FIFO replacement policy.
+ *
+ * @param set Target set.
+ *
+ * @returns Upon successful completion, the index of the page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_fifo(int set)
+{
+	int slot_idx;
+	int draw_count = 1;
+	AGE_TYPE age;
+	AGE_TYPE min_age;
+	int first = set*RMEM_CACHE_WAYS;
+	int last = first + RMEM_CACHE_WAYS;
+
+	cache_time++;
+
+	/* Cache has space. */
+	for (int i = first; i < last; i++)
+	{
+		if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum == RMEM_NULL)
 		    return (i*RMEM_CACHE_BLOCK_SIZE);
 	}
 
 	/* No space. Make evict. */
-	min_age = cache_lines[slot_idx = 0].age;
-	for (int i = 1; i < RMEM_CACHE_LENGTH; i++)
+	slot_idx = -1;
+	min_age = 0;
+	for (int i = first; i < last; i++)
 	{
+		/* Pinned line. */
+		if (i == cache_pinned)
+			continue;
+
 		age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age;
-		if (age < min_age)
+		if ((slot_idx < 0) || (age < min_age))
 		{
 		    slot_idx = i*RMEM_CACHE_BLOCK_SIZE;
 		    min_age = age;
@@ -450,12 +1069,19 @@ static int nanvix_rcache_fifo(void)
 		}
 	}
 
+	/* Only the pinned line is left. */
+	if (slot_idx < 0)
+		return (-EBUSY);
+
 	if (draw_count > 1)
 	{
         int random_number = random_mod(draw_count);
 		int encounter_number = 0;
-		for (int i = (slot_idx/RMEM_CACHE_BLOCK_SIZE); i < RMEM_CACHE_LENGTH; i++)
+		for (int i = (slot_idx/RMEM_CACHE_BLOCK_SIZE); i < last; i++)
 		{
+			if (i == cache_pinned)
+				continue;
+
 			if ((age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age) == min_age)
 			{
 				if (encounter_number == random_number)
@@ -465,90 +1091,476 @@ static int nanvix_rcache_fifo(void)
 		}
 	}
 
-	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
-		if (nanvix_rcache_flush(cache_lines[slot_idx+i].pgnum) < 0)
-			return (-EFAULT);
+	if (nanvix_rcache_line_writeback(slot_idx) < 0)
+		return (-EFAULT);
+
+	return slot_idx;
+}
+
+/*============================================================================*
+ * nanvix_rcache_nfu()                                                        *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+static int nanvix_rcache_nfu(int set)
+{
+	return (nanvix_rcache_fifo(set));
+}
+
+/*============================================================================*
+ * nanvix_rcache_lifo()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Evicts pages from the cache based on the LIFO replacement policy.
+ *
+ * @param set Target set.
+ *
+ * @returns Upon successful completion, the index of the page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_lifo(int set)
+{
+	int slot_idx;
+	int age;
+	int max_age;
+	int first = set*RMEM_CACHE_WAYS;
+	int last = first + RMEM_CACHE_WAYS;
+
+	cache_time++;
+
+	/* Cache has space. */
+	for (int i = first; i < last; i++)
+	{
+		if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum == RMEM_NULL)
+		    return (i*RMEM_CACHE_BLOCK_SIZE);
+	}
+
+	/* No space. Make evict. */
+	slot_idx = -1;
+	max_age = 0;
+	for (int i = first; i < last; i++)
+	{
+		/* Pinned line. */
+		if (i == cache_pinned)
+			continue;
+
+		if (((age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age) > max_age) || (slot_idx < 0))
+		{
+		    slot_idx = i*RMEM_CACHE_BLOCK_SIZE;
+		    max_age = age;
+		}
+	}
+
+	/* Only the pinned line is left. */
+	if (slot_idx < 0)
+		return (-EBUSY);
+
+	if (nanvix_rcache_line_writeback(slot_idx) < 0)
+		return (-EFAULT);
+
+	return slot_idx;
+}
+
+/*============================================================================*
+ * nanvix_rcache_lru()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Evicts pages from the cache based on the LRU replacement policy.
+ *
+ * Resident lines are kept in T1 in recency order, thus the victim is
+ * found in constant time.
+ *
+ * @param set Target set.
+ *
+ * @returns Upon successful completion, the index of the page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_lru(int set)
+{
+	int line;
+
+	cache_time++;
+
+	/* No space. Evict least recently used line. */
+	if ((line = cache_lists[set][RMEM_CACHE_LIST_FREE].head) < 0)
+	{
+		/* Only the pinned line is left. */
+		if ((line = nanvix_rcache_list_victim(set, RMEM_CACHE_LIST_T1)) < 0)
+			return (-EBUSY);
+
+		if (nanvix_rcache_line_writeback(line*RMEM_CACHE_BLOCK_SIZE) < 0)
+			return (-EFAULT);
+	}
+
+	nanvix_rcache_list_push(RMEM_CACHE_LIST_T1, line);
+
+	return (line*RMEM_CACHE_BLOCK_SIZE);
+}
+
+/*============================================================================*
+ * nanvix_rcache_clock()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Evicts pages from the cache based on the CLOCK replacement
+ * policy.
+ *
+ * The clock hand sweeps over lines of the set, clearing reference
+ * bits, until it finds a line that was not referenced since the last
+ * sweep.
+ *
+ * @param set Target set.
+ *
+ * @returns Upon successful completion, the index of the page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_clock(int set)
+{
+	int line;
+	int first = set*RMEM_CACHE_WAYS;
+
+	cache_time++;
+
+	/* No space. Give referenced lines a second chance. */
+	if ((line = cache_lists[set][RMEM_CACHE_LIST_FREE].head) < 0)
+	{
+		/* Only the pinned line is left. */
+		if ((RMEM_CACHE_WAYS == 1) && (cache_pinned == first))
+			return (-EBUSY);
+
+		while ((cache_lines[(first + cache_hand[set])*RMEM_CACHE_BLOCK_SIZE].referenced) ||
+			((first + cache_hand[set]) == cache_pinned))
+		{
+			cache_lines[(first + cache_hand[set])*RMEM_CACHE_BLOCK_SIZE].referenced = 0;
+			cache_hand[set] = (cache_hand[set] + 1) % RMEM_CACHE_WAYS;
+		}
+
+		line = first + cache_hand[set];
+		cache_hand[set] = (cache_hand[set] + 1) % RMEM_CACHE_WAYS;
+
+		if (nanvix_rcache_line_writeback(line*RMEM_CACHE_BLOCK_SIZE) < 0)
+			return (-EFAULT);
+	}
+
+	nanvix_rcache_list_push(RMEM_CACHE_LIST_T1, line);
+	cache_lines[line*RMEM_CACHE_BLOCK_SIZE].referenced = 1;
+
+	return (line*RMEM_CACHE_BLOCK_SIZE);
+}
+
+/*============================================================================*
+ * nanvix_rcache_arc()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Evicts pages from the cache based on the ARC replacement policy.
+ *
+ * Lines referenced once are kept in T1, and lines referenced more
+ * than once in T2. Ghosts of lines evicted from T1 and T2 are kept in
+ * B1 and B2, respectively. A miss on a ghost adapts the target length
+ * of T1 towards the list that would have kept the line cached.
+ *
+ * @param set   Target set.
+ * @param pgnum Number of the target page.
+ *
+ * @returns Upon successful completion, the index of the page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_arc(int set, rpage_t pgnum)
+{
+	int line;
+	int node;
+	int t1, b1, b2;
+	int target = arc_target[set];
+	int frequent = 0;
+	int evicted = 0;
+	int list = RMEM_CACHE_LIST_T1;
+
+	cache_time++;
+
+	t1 = nanvix_rcache_list_length(set, RMEM_CACHE_LIST_T1);
+	b1 = nanvix_rcache_list_length(set, RMEM_CACHE_LIST_B1);
+	b2 = nanvix_rcache_list_length(set, RMEM_CACHE_LIST_B2);
+
+	/* Ghost hit. */
+	if ((node = nanvix_rcache_ghost_lookup(pgnum)) >= 0)
+	{
+		if (cache_nodes[node].list == RMEM_CACHE_LIST_B1)
+		{
+			target += (b2 > b1) ? b2/b1 : 1;
+			if (target > RMEM_CACHE_WAYS)
+				target = RMEM_CACHE_WAYS;
+		}
+		else
+		{
+			frequent = 1;
+			target -= (b1 > b2) ? b1/b2 : 1;
+			if (target < 0)
+				target = 0;
+		}
+
+		list = RMEM_CACHE_LIST_T2;
+	}
+
+	/* No space. Evict a line. */
+	if ((line = cache_lists[set][RMEM_CACHE_LIST_FREE].head) < 0)
+	{
+		int from = RMEM_CACHE_LIST_T2;
+
+		if ((t1 > 0) && ((t1 > target) || (frequent && (t1 == target)) ||
+			(nanvix_rcache_list_length(set, RMEM_CACHE_LIST_T2) == 0)))
+			from = RMEM_CACHE_LIST_T1;
+
+		/* Fall back to the other list if only the pinned line is left. */
+		if ((line = nanvix_rcache_list_victim(set, from)) < 0)
+		{
+			from = (from == RMEM_CACHE_LIST_T1) ? RMEM_CACHE_LIST_T2 : RMEM_CACHE_LIST_T1;
+			if ((line = nanvix_rcache_list_victim(set, from)) < 0)
+				return (-EBUSY);
+		}
+
+		if (nanvix_rcache_line_writeback(line*RMEM_CACHE_BLOCK_SIZE) < 0)
+			return (-EFAULT);
+
+		evicted = 1;
+	}
+
+	arc_target[set] = target;
+
+	/* Bound the ghost lists. */
+	if (node >= 0)
+		nanvix_rcache_ghost_drop(node);
+	else if (t1 + b1 >= RMEM_CACHE_WAYS)
+	{
+		/* T1 fills the set, thus its victim leaves no ghost. */
+		if (b1 == 0)
+			evicted = 0;
+		else
+			nanvix_rcache_ghost_drop(cache_lists[set][RMEM_CACHE_LIST_B1].tail);
+	}
+	else if ((b1 + b2 >= RMEM_CACHE_WAYS) && (b2 > 0))
+		nanvix_rcache_ghost_drop(cache_lists[set][RMEM_CACHE_LIST_B2].tail);
+
+	if (evicted)
+	{
+		nanvix_rcache_ghost_add(
+			(cache_nodes[line].list == RMEM_CACHE_LIST_T1) ?
+				RMEM_CACHE_LIST_B1 : RMEM_CACHE_LIST_B2,
+			line
+		);
+	}
+
+	nanvix_rcache_list_push(list, line);
+
+	return (line*RMEM_CACHE_BLOCK_SIZE);
+}
+
+/*============================================================================*
+ * nanvix_rcache_replacement_policies()                                       *
+ *============================================================================*/
+
+/**
+ * @brief Selects the replacement policy function based on the
+ * replacement policy number.
+ *
+ * The victim is chosen among lines of the set where the target page
+ * is placed.
+ *
+ * @param pgnum Number of the target page.
+ *
+ * @returns Upon successful completion, the free index of a page is
+ * returned. Upon failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_replacement_policies(rpage_t pgnum)
+{
+	int set = nanvix_rcache_set(pgnum);
+
+	if (cache_policy == RMEM_CACHE_FIFO)
+		return (nanvix_rcache_fifo(set));
+
+	if (cache_policy == RMEM_CACHE_LIFO)
+		return (nanvix_rcache_lifo(set));
+
+	if (cache_policy == RMEM_CACHE_LRU)
+		return (nanvix_rcache_lru(set));
+
+	if (cache_policy == RMEM_CACHE_CLOCK)
+		return (nanvix_rcache_clock(set));
+
+	if (cache_policy == RMEM_CACHE_ARC)
+		return (nanvix_rcache_arc(set, pgnum));
+
+	return (nanvix_rcache_nfu(set));
+}
+
+/*============================================================================*
+ * nanvix_rcache_line_wait()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Waits for a line of the page cache that is being read ahead.
+ *
+ * Pages whose transfer fails are released.
+ *
+ * @param slot_idx Index of the first slot of the target line.
+ *
+ * @returns If all pages of the line have arrived, zero is returned.
+ * Otherwise, a negative error code is returned instead.
+ */
+static int nanvix_rcache_line_wait(int slot_idx)
+{
+	int ret = 0;
+
+	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
+	{
+		if (nanvix_rcache_slot_wait(slot_idx + i) < 0)
+		{
+			nanvix_rcache_slot_set(slot_idx + i, RMEM_NULL);
+			ret = -EFAULT;
+		}
+	}
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_rcache_line_prefetch()                                              *
+ *============================================================================*/
+
+/**
+ * @brief Reads ahead a line of the page cache.
+ *
+ * Pages of the line are read asynchronously, and they are waited for
+ * on their first access.
+ *
+ * @param pgnum  Number of the first page of the line.
+ * @param stream Access stream that reads ahead the line.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure a negative error code is returned instead.
+ */
+static int nanvix_rcache_line_prefetch(rpage_t pgnum, int stream)
+{
+	int tag;
+	int slot_idx;
+
+	/* Invalid page number. */
+	if (RMEM_BLOCK_NUM(pgnum) >= RMEM_NUM_BLOCKS)
+		return (-EINVAL);
+
+	/* Line already cached. */
+	if (nanvix_rcache_index_lookup(pgnum) >= 0)
+		return (0);
+
+	if ((slot_idx = nanvix_rcache_replacement_policies(pgnum)) < 0)
+		return (slot_idx);
+
+	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
+	{
+		nanvix_rcache_slot_set(slot_idx + i, (rpage_t)(pgnum + i));
+
+		/* Skip pages that lie beyond remote memory. */
+		if (RMEM_BLOCK_NUM(pgnum + i) >= RMEM_NUM_BLOCKS)
+			continue;
+
+		/* Too many outstanding reads. */
+		if ((tag = nanvix_rmem_read_async(pgnum + i, cache_lines[slot_idx + i].pages)) < 0)
+		{
+			nanvix_rcache_slot_set(slot_idx + i, RMEM_NULL);
+
+			if (i == 0)
+				return (-EBUSY);
 
-	return slot_idx;
-}
+			continue;
+		}
 
-/*============================================================================*
- * nanvix_rcache_nfu()                                                        *
- *============================================================================*/
+		cache_lines[slot_idx + i].tag = tag;
+	}
 
-/**
- * @todo TODO: provide a detailed description for this function.
- */
-static int nanvix_rcache_nfu(void)
-{
-	return (nanvix_rcache_fifo());
+	cache_lines[slot_idx].prefetched = 1;
+	cache_lines[slot_idx].stream = stream;
+	cache_lines[slot_idx].stream_birth = cache_streams[stream].birth;
+	nanvix_rcache_age_init(pgnum);
+
+	return (0);
 }
 
 /*============================================================================*
- * nanvix_rcache_lifo()                                                       *
+ * nanvix_rcache_readahead()                                                  *
  *============================================================================*/
 
 /**
- * @brief Evicts pages from the cache based on the LIFO replacement policy.
+ * @brief Reads ahead lines that follow a line of the page cache.
  *
- * @param pgnum Number of the target page.
+ * Demand accesses to consecutive lines form a stream. The readahead
+ * window of a stream doubles on each sequential access, and it halves
+ * whenever a line that was read ahead is evicted before being used.
+ * The target line is pinned meanwhile, so that it is not evicted.
  *
- * @returns Upon successful completion, the index of the page is
- * returned. Upon failure a negative error code is returned instead.
+ * @param slot_idx Index of the first slot of the target line.
  */
-static int nanvix_rcache_lifo(void)
+static void nanvix_rcache_readahead(int slot_idx)
 {
-	int slot_idx;
-	int age;
-	int max_age;
+	int s;
+	rpage_t end;
+	rpage_t pgnum = cache_lines[slot_idx].pgnum;
 
-	cache_time++;
+	/* Readahead disabled. */
+	if (readahead_max == 0)
+		return;
 
-	/* Cache has space. */
-	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
+	for (s = 0; s < RMEM_CACHE_STREAMS_MAX; s++)
 	{
-		if (cache_lines[i*RMEM_CACHE_BLOCK_SIZE].pgnum == RMEM_NULL)
-		    return (i*RMEM_CACHE_BLOCK_SIZE);
+		if (cache_streams[s].next == pgnum)
+			break;
 	}
 
-	/* No space. Make evict. */
-	max_age = cache_lines[slot_idx = 0].age;
-	for (int i = 1; i < RMEM_CACHE_LENGTH; i++)
+	/* New stream. Replace the least recently accessed one. */
+	if (s == RMEM_CACHE_STREAMS_MAX)
 	{
-		if ((age = cache_lines[i*RMEM_CACHE_BLOCK_SIZE].age) > max_age)
+		s = 0;
+		for (int i = 1; i < RMEM_CACHE_STREAMS_MAX; i++)
 		{
-		    slot_idx = i*RMEM_CACHE_BLOCK_SIZE;
-		    max_age = age;
+			if (cache_streams[i].age < cache_streams[s].age)
+				s = i;
 		}
+
+		cache_streams[s].next = pgnum + RMEM_CACHE_BLOCK_SIZE;
+		cache_streams[s].ahead = pgnum + RMEM_CACHE_BLOCK_SIZE;
+		cache_streams[s].window = 0;
+		cache_streams[s].age = cache_time;
+		cache_streams[s].birth = cache_time;
+
+		return;
 	}
 
-	for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
-		if (nanvix_rcache_flush(cache_lines[slot_idx+i].pgnum) < 0)
-			return (-EFAULT);
+	/* Sequential access. Grow window. */
+	cache_streams[s].window = (cache_streams[s].window == 0) ? 1 : 2*cache_streams[s].window;
+	if (cache_streams[s].window > readahead_max)
+		cache_streams[s].window = readahead_max;
+	cache_streams[s].next = pgnum + RMEM_CACHE_BLOCK_SIZE;
+	cache_streams[s].age = cache_time;
 
-	return slot_idx;
-}
+	if (cache_streams[s].ahead < cache_streams[s].next)
+		cache_streams[s].ahead = cache_streams[s].next;
 
-/*============================================================================*
- * nanvix_rcache_replacement_policies()                                       *
- *============================================================================*/
+	end = cache_streams[s].next + cache_streams[s].window*RMEM_CACHE_BLOCK_SIZE;
 
-/**
- * @brief Selects the replacement policy function based on the
- * replacement policy number.
- *
- * @returns Upon successful completion, the free index of a page is
- * returned. Upon failure a negative error code is returned instead.
- */
-static int nanvix_rcache_replacement_policies(void)
-{
-	if (cache_policy == RMEM_CACHE_FIFO)
-		return (nanvix_rcache_fifo());
+	cache_pinned = slot_idx/RMEM_CACHE_BLOCK_SIZE;
 
-	if (cache_policy == RMEM_CACHE_LIFO)
-		return (nanvix_rcache_lifo());
+	while (cache_streams[s].ahead < end)
+	{
+		if (nanvix_rcache_line_prefetch(cache_streams[s].ahead, s) < 0)
+			break;
+
+		cache_streams[s].ahead += RMEM_CACHE_BLOCK_SIZE;
+	}
 
-	return (nanvix_rcache_nfu());
+	cache_pinned = -1;
 }
 
 /*============================================================================*
@@ -568,7 +1580,19 @@ int nanvix_rcache_select_replacement_policy(int num)
 		case RMEM_CACHE_LIFO:
 		case RMEM_CACHE_NFU:
 		case RMEM_CACHE_AGING:
+		case RMEM_CACHE_LRU:
+		case RMEM_CACHE_CLOCK:
+		case RMEM_CACHE_ARC:
 		case RMEM_CACHE_BYPASS:
+			/* Lists of the former policy are meaningless. */
+			if (num != cache_policy)
+			{
+				/* Settle pages that are being read ahead. */
+				for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
+					nanvix_rcache_line_wait(i*RMEM_CACHE_BLOCK_SIZE);
+
+				nanvix_rcache_lists_reset();
+			}
 			cache_policy = num;
 			break;
 		default:
@@ -600,6 +1624,44 @@ int nanvix_rcache_select_write(int num)
 	return (0);
 }
 
+/*============================================================================*
+ * nanvix_rcache_select_readahead()                                           *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_select_readahead() function sets the maximum
+ * length of readahead windows to @p nlines lines. If @p nlines is
+ * zero, readahead is disabled.
+ */
+int nanvix_rcache_select_readahead(int nlines)
+{
+	cache_time++;
+
+	/* Invalid window length. */
+	if (!WITHIN(nlines, 0, RMEM_CACHE_READAHEAD_MAX + 1))
+		return (-EFAULT);
+
+	readahead_max = nlines;
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_rcache_stats()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_stats() function stores the number of hits and
+ * misses of the page cache in @p nhits and @p nmisses, respectively.
+ */
+void nanvix_rcache_stats(unsigned *nhits, unsigned *nmisses)
+{
+	if (nhits != NULL)
+		*nhits = stats.nhits;
+	if (nmisses != NULL)
+		*nmisses = stats.nmisses;
+}
+
 /*============================================================================*
  * nanvix_rcache_ralloc()                                                     *
  *============================================================================*/
@@ -621,12 +1683,39 @@ rpage_t nanvix_rcache_alloc(void)
 	return (pgnum);
 }
 
+/*============================================================================*
+ * nanvix_rcache_alloc_n()                                                    *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_alloc_n() function allocates @p n remote pages
+ * at once and stores their numbers in @p pgnums.
+ */
+int nanvix_rcache_alloc_n(rpage_t *pgnums, int n)
+{
+	int err;
+
+	cache_time++;
+
+	/* Forward allocation to remote memory. */
+	if ((err = nanvix_rmem_alloc_n(pgnums, n)) < 0)
+		return (err);
+
+	stats.nallocs += n;
+	return (0);
+}
+
 /*============================================================================*
  * nanvix_rcache_flush()                                                      *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * The nanvix_rcache_flush() function writes back the page @p pgnum,
+ * and then waits for pages that were previously evicted from the
+ * cache to be written back as well. Remote memory servers apply
+ * requests of a client in order, thus the fence is only needed to
+ * order the flush against write-backs to other servers. Errors on
+ * these write-backs are reported by the flush.
  */
 int nanvix_rcache_flush(rpage_t pgnum)
 {
@@ -640,6 +1729,10 @@ int nanvix_rcache_flush(rpage_t pgnum)
 
 	cache_time++;
 
+	/* Wait for pages that are being read ahead. */
+	if ((error >= 0) && (nanvix_rcache_line_wait(slot) < 0))
+		error = nanvix_rcache_page_search(pgnum).error;
+
 	if (error < 0)
 		return (-EFAULT);
 
@@ -651,12 +1744,42 @@ int nanvix_rcache_flush(rpage_t pgnum)
 	if ((err = nanvix_rmem_write(pgnum, cache_lines[slot+block].pages)) < 0)
 		return (err);
 
+	cache_lines[slot+block].dirty = 0;
+
+	/* Wait for evicted pages. */
+	if ((err = nanvix_rmem_fence()) < 0)
+		return (err);
+
 #ifdef CACHE_DEBUG
 	uprintf("[benchmark] %d misses, %d hits", stats.nmisses, stats.nhits);
 #endif
 	return (0);
 }
 
+/*============================================================================*
+ * nanvix_rcache_mark_dirty()                                                 *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_mark_dirty() function marks the cached copy of the
+ * page @p pgnum as modified, so that it is written back to remote
+ * memory when evicted from the cache.
+ */
+int nanvix_rcache_mark_dirty(rpage_t pgnum)
+{
+	int slot;
+
+	cache_time++;
+
+	/* Page not loaded into the cache. */
+	if ((slot = nanvix_rcache_index_lookup(pgnum)) < 0)
+		return (-EFAULT);
+
+	cache_lines[slot].dirty = 1;
+
+	return (0);
+}
+
 /*============================================================================*
  * nanvix_rcache_free()                                                       *
  *============================================================================*/
@@ -666,6 +1789,8 @@ int nanvix_rcache_flush(rpage_t pgnum)
  */
 int nanvix_rcache_free(rpage_t pgnum)
 {
+	int slot;
+
 	cache_time++;
 
 	/* Invalid page number. */
@@ -673,24 +1798,94 @@ int nanvix_rcache_free(rpage_t pgnum)
 		return (-EFAULT);
 
 	/* Check if target page is loaded into the cache. */
-	for (int i = 0; i < RMEM_CACHE_LENGTH; i++)
-	{
-		if (cache_lines[i].pgnum == pgnum)
-		    cache_lines[i].pgnum = RMEM_NULL;
-	}
+	if ((slot = nanvix_rcache_index_lookup(pgnum)) >= 0)
+		nanvix_rcache_slot_set(slot, RMEM_NULL);
 
 	stats.nallocs--;
 	return (nanvix_rmem_free(pgnum));
 }
 
+/*============================================================================*
+ * nanvix_rcache_free_n()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_free_n() function frees the @p n remote pages
+ * listed in @p pgnums at once.
+ */
+int nanvix_rcache_free_n(const rpage_t *pgnums, int n)
+{
+	int slot;
+
+	cache_time++;
+
+	/* Invalid list of pages. */
+	if ((pgnums == NULL) || (n <= 0))
+		return (-EINVAL);
+
+	for (int j = 0; j < n; j++)
+	{
+		/* Invalid page number. */
+		if ((pgnums[j] == RMEM_NULL) || (RMEM_BLOCK_NUM(pgnums[j]) >= RMEM_NUM_BLOCKS))
+			return (-EFAULT);
+
+		/* Check if target page is loaded into the cache. */
+		if ((slot = nanvix_rcache_index_lookup(pgnums[j])) >= 0)
+			nanvix_rcache_slot_set(slot, RMEM_NULL);
+	}
+
+	stats.nallocs -= n;
+	return (nanvix_rmem_free_n(pgnums, n));
+}
+
+/*============================================================================*
+ * nanvix_rcache_clone()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_clone() function clones the remote page @p pgnum.
+ * If the page is loaded into the cache, it is written back first, so
+ * that the clone sees the latest contents of the page.
+ */
+rpage_t nanvix_rcache_clone(rpage_t pgnum)
+{
+	rpage_t clone;
+
+	cache_time++;
+
+	/* Invalid page number. */
+	if ((pgnum == RMEM_NULL) || (RMEM_BLOCK_NUM(pgnum) >= RMEM_NUM_BLOCKS))
+		return (RMEM_NULL);
+
+	/* Write back cached copy. */
+	if (nanvix_rcache_page_search(pgnum).error >= 0)
+	{
+		if (nanvix_rcache_flush(pgnum) < 0)
+			return (RMEM_NULL);
+	}
+
+	if ((clone = nanvix_rmem_clone(pgnum)) == RMEM_NULL)
+		return (RMEM_NULL);
+
+	stats.nallocs++;
+	return (clone);
+}
+
 /*============================================================================*
  * nanvix_rcache_get()                                                        *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Gets a remote page.
+ *
+ * @param pgnum     Number of the target page.
+ * @param readahead Read ahead lines that follow?
+ *
+ * @returns Upon successful completion, a pointer to a local copy of
+ * the target page is returned. Upon failure, a @p NULL pointer is
+ * returned instead.
  */
-void *nanvix_rcache_get(rpage_t pgnum)
+static void *nanvix_rcache_do_get(rpage_t pgnum, int readahead)
 {
 	int err;
 	int evict_idx;
@@ -710,28 +1905,45 @@ void *nanvix_rcache_get(rpage_t pgnum)
 	/* Normal mode. */
 	if (cache_policy != RMEM_CACHE_BYPASS)
 	{
+		/* Wait for pages of the line that are being read ahead. */
+		if ((error >= 0) && (nanvix_rcache_line_wait(slot) < 0))
+		{
+			idx = nanvix_rcache_page_search(pgnum);
+			slot = idx.slot_idx;
+			block = idx.block_idx;
+			error = idx.error;
+		}
+
 		if (error >= 0)
 		{
 			stats.nhits++;
-			nanvix_rcache_age_update(pgnum);
+			nanvix_rcache_age_update(slot);
 			cache_lines[slot].ref_count++;
+
+			/* First access to a line that was read ahead. */
+			if (cache_lines[slot].prefetched)
+			{
+				cache_lines[slot].prefetched = 0;
+				if (readahead)
+					nanvix_rcache_readahead(slot);
+			}
+
 			return (cache_lines[slot+block].pages);
 		}
 
 		stats.nmisses++;
-		if ((evict_idx = nanvix_rcache_replacement_policies()) < 0)
+		if ((evict_idx = nanvix_rcache_replacement_policies(pgnum)) < 0)
 			return (NULL);
 		/* Load page remote page. */
-		for (int i = 0; i < RMEM_CACHE_BLOCK_SIZE; i++)
-		{
-			if ((err = nanvix_rmem_read((rpage_t)(pgnum+i), cache_lines[evict_idx+i].pages)) < 0)
-				return (NULL);
-			cache_lines[evict_idx+i].pgnum = (rpage_t)(pgnum+i);
-		}
+		nanvix_rcache_line_load(evict_idx, pgnum);
 
 		cache_lines[evict_idx].ref_count++;
 		nanvix_rcache_age_init(pgnum);
 
+		/* Read ahead lines that follow. */
+		if (readahead)
+			nanvix_rcache_readahead(evict_idx);
+
 		ptr = cache_lines[evict_idx].pages;
 	}
 	/* Bypass mode. */
@@ -741,9 +1953,10 @@ void *nanvix_rcache_get(rpage_t pgnum)
 
 		nanvix_rcache_line_lock(0);
 
-			if ((cache_lines[0].valid) && (cache_lines[0].pgnum != RMEM_NULL))
+			/* Evict page. */
+			if ((cache_lines[0].valid) && (cache_lines[0].pgnum != RMEM_NULL) && (cache_lines[0].dirty))
 			{
-				if (nanvix_rcache_flush(cache_lines[0].pgnum))
+				if (nanvix_rmem_write_posted(cache_lines[0].pgnum, cache_lines[0].pages) != RMEM_BLOCK_SIZE)
 				{
 					nanvix_rcache_line_unlock(0);
 					return (NULL);
@@ -757,7 +1970,7 @@ void *nanvix_rcache_get(rpage_t pgnum)
 			}
 
 			cache_lines[0].valid = 1;
-			cache_lines[0].pgnum = pgnum;
+			nanvix_rcache_slot_set(0, pgnum);
 			ptr = cache_lines[0].pages;
 
 		nanvix_rcache_line_unlock(0);
@@ -770,6 +1983,29 @@ void *nanvix_rcache_get(rpage_t pgnum)
 	return (ptr);
 }
 
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+void *nanvix_rcache_get(rpage_t pgnum)
+{
+	return (nanvix_rcache_do_get(pgnum, 1));
+}
+
+/*============================================================================*
+ * nanvix_rcache_get_noreadahead()                                            *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_get_noreadahead() function gets the remote page
+ * @p pgnum, as nanvix_rcache_get() does, but it does not read ahead
+ * lines that follow. Thus, the only line that may be evicted is the
+ * one that the page is loaded into.
+ */
+void *nanvix_rcache_get_noreadahead(rpage_t pgnum)
+{
+	return (nanvix_rcache_do_get(pgnum, 0));
+}
+
 /*============================================================================*
  * nanvix_rcache_put()                                                        *
  *============================================================================*/
@@ -781,6 +2017,7 @@ int nanvix_rcache_put(rpage_t pgnum, int strike)
 {
 	struct tuple idx = nanvix_rcache_page_search(pgnum);
 	int slot = idx.slot_idx;
+	int block = idx.block_idx;
 	int error = idx.error;
 
 	cache_time++;
@@ -805,6 +2042,9 @@ int nanvix_rcache_put(rpage_t pgnum, int strike)
 		if (cache_lines[slot].ref_count <= 0)
 			return (-EFAULT);
 
+		/* The page may have been modified. */
+		cache_lines[slot+block].dirty = 1;
+
 		if ((write_policy == RMEM_CACHE_WRITE_THROUGH) && (nanvix_rcache_flush(pgnum) < 0))
 			return (-EFAULT);
 
@@ -829,6 +2069,8 @@ int nanvix_rcache_put(rpage_t pgnum, int strike)
 					nanvix_rcache_line_unlock(0);
 					return (err);
 				}
+
+				cache_lines[0].dirty = 0;
 			}
 
 		nanvix_rcache_line_unlock(0);
@@ -840,6 +2082,120 @@ int nanvix_rcache_put(rpage_t pgnum, int strike)
 	return (0);
 }
 
+/*============================================================================*
+ * nanvix_rcache_read()                                                       *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_read() function reads @p n bytes starting at
+ * offset @p offset of the remote page @p pgnum into @p buf. In bypass
+ * mode, if the target page is not the one that is currently held by
+ * the cache, only the requested byte range is fetched from the remote
+ * memory.
+ */
+size_t nanvix_rcache_read(rpage_t pgnum, void *buf, size_t offset, size_t n)
+{
+	size_t ret;
+	char *ptr;
+
+	/* Invalid page number. */
+	if ((pgnum == RMEM_NULL) || (RMEM_BLOCK_NUM(pgnum) >= RMEM_NUM_BLOCKS))
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	/* Normal mode. */
+	if (cache_policy != RMEM_CACHE_BYPASS)
+	{
+		if ((ptr = nanvix_rcache_get(pgnum)) == NULL)
+			return (0);
+
+		umemcpy(buf, &ptr[offset], n);
+
+		return (n);
+	}
+
+	/* Bypass mode. */
+	nanvix_rcache_line_lock(0);
+
+		/* Read from cached copy. */
+		if ((cache_lines[0].valid) && (cache_lines[0].pgnum == pgnum))
+		{
+			stats.nhits++;
+			umemcpy(buf, &cache_lines[0].pages[offset], n);
+			ret = n;
+		}
+		else
+		{
+			stats.nmisses++;
+			ret = nanvix_rmem_read_partial(pgnum, buf, offset, n);
+		}
+
+	nanvix_rcache_line_unlock(0);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_rcache_write()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_rcache_write() function writes @p n bytes from @p buf
+ * starting at offset @p offset of the remote page @p pgnum. In bypass
+ * mode, if the target page is not the one that is currently held by
+ * the cache, only the requested byte range is sent to the remote
+ * memory.
+ */
+size_t nanvix_rcache_write(rpage_t pgnum, const void *buf, size_t offset, size_t n)
+{
+	size_t ret;
+	char *ptr;
+
+	/* Invalid page number. */
+	if ((pgnum == RMEM_NULL) || (RMEM_BLOCK_NUM(pgnum) >= RMEM_NUM_BLOCKS))
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	/* Normal mode. */
+	if (cache_policy != RMEM_CACHE_BYPASS)
+	{
+		if ((ptr = nanvix_rcache_get(pgnum)) == NULL)
+			return (0);
+
+		umemcpy(&ptr[offset], buf, n);
+		nanvix_rcache_mark_dirty(pgnum);
+
+		return (n);
+	}
+
+	/* Bypass mode. */
+	nanvix_rcache_line_lock(0);
+
+		/* Write to cached copy. */
+		if ((cache_lines[0].valid) && (cache_lines[0].pgnum == pgnum))
+		{
+			stats.nhits++;
+			umemcpy(&cache_lines[0].pages[offset], buf, n);
+			cache_lines[0].dirty = 1;
+			ret = n;
+		}
+		else
+		{
+			stats.nmisses++;
+			ret = nanvix_rmem_write_partial(pgnum, buf, offset, n);
+		}
+
+	nanvix_rcache_line_unlock(0);
+
+	return (ret);
+}
+
 /*============================================================================*
  * nanvix_rcache_setup()                                                      *
  *============================================================================*/
@@ -866,9 +2222,19 @@ int __nanvix_rcache_setup(void)
 		cache_lines[i].busy = 0;
 		cache_lines[i].valid = 0;
 		cache_lines[i].ref_count = 0;
+		cache_lines[i].dirty = 0;
+		cache_lines[i].tag = 0;
+		cache_lines[i].prefetched = 0;
 		spinlock_init(&cache_lines[i].lock);
 	}
 
+	/* Page index. */
+	for (int i = 0; i < RMEM_CACHE_INDEX_LENGTH; i++)
+		cache_index[i].pgnum = RMEM_NULL;
+
+	/* Replacement lists. */
+	nanvix_rcache_lists_reset();
+
 	uprintf("[nanvix][rcache] page cache initialized");
 	initialized = 1;
 
@@ -174,7 +174,6 @@ static int nanvix_vmem_contract(int n)
 void *nanvix_vmem_alloc(size_t n)
 {
 	int base;
-	rpage_t pgnum;
 
 	/* Invalid allocation size */
 	if (n == 0)
@@ -187,16 +186,13 @@ void *nanvix_vmem_alloc(size_t n)
 	if ((base = nanvix_vmem_expand(n)) < 0)
 		return (NULL);
 
-	for (size_t i = 0; i < n; i++)
+	/* Allocate pages. */
+	if (nanvix_rcache_alloc_n(&rmem_table[base], n) < 0)
 	{
-		/* Allocate page. */
-		if ((pgnum = nanvix_rcache_alloc()) == RMEM_NULL)
-			return (NULL);
-
-		rmem_table[base + i] = pgnum;
+		uassert(nanvix_vmem_contract(n) == base + (int) n);
+		return (NULL);
 	}
 
-
 	return ((void *) RADDR(base));
 }
 
@@ -226,21 +222,74 @@ int nanvix_vmem_free(void *ptr)
 	if ((rbrk - base) < 1)
 		return (-EFAULT);
 
-	for (int i = base; i < rbrk; i++)
-	{
-		/* Free underlying remote page. */
-		if ((err = nanvix_rcache_free(rmem_table[i])) < 0)
-			return (err);
+	/* Free underlying remote pages. */
+	if ((err = nanvix_rcache_free_n(&rmem_table[base], rbrk - base)) < 0)
+		return (err);
 
-		/* Update remote memory table. */
+	/* Update remote memory table. */
+	for (int i = base; i < rbrk; i++)
 		rmem_table[i] = RMEM_NULL;
-	}
 
 	err = nanvix_vmem_contract(rbrk - base);
 
 	return ((err < 0) ? err : 0);
 }
 
+/*============================================================================*
+ * nanvix_vmem_clone()                                                        *
+ *============================================================================*/
+
+/**
+ * The nanvix_vmem_clone() function clones the remote memory area that
+ * starts at @p ptr and spans @p n bytes. The clone is placed at the
+ * break of the remote memory.
+ */
+void *nanvix_vmem_clone(const void *ptr, size_t n)
+{
+	int nblocks;    /* Number of blocks. */
+	int newbase;    /* Base of clone.    */
+	raddr_t base;   /* Base address.     */
+	raddr_t offset; /* Offset address.   */
+
+	ptr = (void *)RADDR_INV(ptr);
+
+	/* Invalid clone size. */
+	if (n == 0)
+		return (NULL);
+
+	/* Lookup remote address. */
+	if (nanvix_vmem_lookup(&base, &offset, ptr) < 0)
+		return (NULL);
+
+	nblocks = (offset + n + RMEM_BLOCK_SIZE - 1)/RMEM_BLOCK_SIZE;
+
+	/* Invalid clone size. */
+	if ((int) base + nblocks > rbrk)
+		return (NULL);
+
+	if ((newbase = nanvix_vmem_expand(nblocks)) < 0)
+		return (NULL);
+
+	/* Clone pages. */
+	for (int i = 0; i < nblocks; i++)
+	{
+		rmem_table[newbase + i] = nanvix_rcache_clone(rmem_table[base + i]);
+
+		/* Rollback. */
+		if (rmem_table[newbase + i] == RMEM_NULL)
+		{
+			if (i > 0)
+				uassert(nanvix_rcache_free_n(&rmem_table[newbase], i) == 0);
+			for (int j = 0; j < i; j++)
+				rmem_table[newbase + j] = RMEM_NULL;
+			uassert(nanvix_vmem_contract(nblocks) == newbase + nblocks);
+			return (NULL);
+		}
+	}
+
+	return ((void *) (RADDR(newbase) + offset));
+}
+
 /*============================================================================*
  * nanvix_vmem_read()                                                         *
  *============================================================================*/
@@ -252,10 +301,9 @@ int nanvix_vmem_free(void *ptr)
  */
 size_t nanvix_vmem_read(void *buf, const void *ptr, size_t n)
 {
-	char *rptr;     /* Cached remote page. */
-	int err;        /* Error code.         */
-	raddr_t base;   /* Base address.       */
-	raddr_t offset; /* Offset address.     */
+	int err;        /* Error code.     */
+	raddr_t base;   /* Base address.   */
+	raddr_t offset; /* Offset address. */
 
 	ptr = (void *)RADDR_INV(ptr);
 
@@ -291,12 +339,10 @@ size_t nanvix_vmem_read(void *buf, const void *ptr, size_t n)
 		return (0);
 	}
 
-	/* Get cached remote page. */
-	if ((rptr = nanvix_rcache_get(rmem_table[base])) == NULL)
+	/* Read through the cache. */
+	if (nanvix_rcache_read(rmem_table[base], buf, offset, n) != n)
 		return (0);
 
-	umemcpy(buf, &rptr[offset], n);
-
 	return (n);
 }
 
@@ -311,10 +357,9 @@ size_t nanvix_vmem_read(void *buf, const void *ptr, size_t n)
  */
 size_t nanvix_vmem_write(void *ptr, const void *buf, size_t n)
 {
-	char *rptr;     /* Cached remote page. */
-	int err;        /* Error code.         */
-	raddr_t base;   /* Base address.       */
-	raddr_t offset; /* Offset address.     */
+	int err;        /* Error code.     */
+	raddr_t base;   /* Base address.   */
+	raddr_t offset; /* Offset address. */
 
 	ptr = (void *)RADDR_INV(ptr);
 
@@ -350,12 +395,10 @@ size_t nanvix_vmem_write(void *ptr, const void *buf, size_t n)
 		return (0);
 	}
 
-	/* Get cached remote page. */
-	if ((rptr = nanvix_rcache_get(rmem_table[base])) == NULL)
+	/* Write through the cache. */
+	if (nanvix_rcache_write(rmem_table[base], buf, offset, n) != n)
 		return (0);
 
-	umemcpy(&rptr[offset], buf, n);
-
 	return (n);
 }
 
@@ -379,7 +422,7 @@ static struct
  */
 int nanvix_rfault(vaddr_t vaddr)
 {
-	int idx = 0;  /* Idex to table of page maps.  */
+	int idx = -1; /* Idex to table of page maps.  */
 	void *lptr;   /* Local pointer.               */
 	void *rptr;   /* Remote pointer.              */
 	raddr_t base; /* Base address of remote page. */
@@ -391,10 +434,20 @@ int nanvix_rfault(vaddr_t vaddr)
 	if (nanvix_vmem_lookup(&base, NULL, lptr) < 0)
 		return (-EFAULT);
 
-	/* Get cached remote page. */
-	if ((rptr = nanvix_rcache_get(rmem_table[base])) == NULL)
+	/*
+	 * Get cached remote page. Lines that are read ahead would
+	 * evict pages that are mapped, thus readahead is skipped.
+	 */
+	if ((rptr = nanvix_rcache_get_noreadahead(rmem_table[base])) == NULL)
 		return (-EFAULT);
 
+	/*
+	 * Mapped pages are written in place and there are no
+	 * write-protect faults to tell writes apart, thus the page
+	 * is assumed to be modified.
+	 */
+	uassert(nanvix_rcache_mark_dirty(rmem_table[base]) == 0);
+
 	/* Unlink old page page from there. */
 	for (int i = 0; i < RMEM_CACHE_SIZE; i++)
 	{
@@ -405,10 +458,14 @@ int nanvix_rfault(vaddr_t vaddr)
 			goto done;
 		}
 
-		/* Remember this index. */
-		idx = i;
+		/* Remember a free entry. */
+		if (maps[i].raddr == NULL)
+			idx = i;
 	}
 
+	/* Each page of the cache is mapped at most once. */
+	uassert(idx >= 0);
+
 done:
 
 	/* Link page. */
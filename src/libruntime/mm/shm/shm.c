@@ -652,7 +652,6 @@ int __nanvix_shm_close(int shmid)
  */
 static ssize_t __do_nanvix_shm_read(int shmid, void *buf, size_t n, off_t off)
 {
-	char *ptr;  /* Local page.                       */
 	int oshmid; /* ID of Opened Shared Memory Region */
 
 	/* Invalid shared memory region. */
@@ -667,11 +666,8 @@ static ssize_t __do_nanvix_shm_read(int shmid, void *buf, size_t n, off_t off)
 	if (oregions[oshmid].page == RMEM_NULL)
 		return (-ENOMEM);
 
-	((void) off);
-
-	uassert((ptr = nanvix_rcache_get(oregions[oshmid].page)) != NULL);
-	umemcpy(buf, ptr + off, n);
-	uassert(nanvix_rcache_put(oregions[oshmid].page, 1) == 0);
+	/* Read without dirtying the cached page. */
+	uassert(nanvix_rcache_read(oregions[oshmid].page, buf, off, n) == n);
 
 	return (n);
 }
@@ -42,80 +42,2407 @@ static struct
 	int initialized; /**< Is the connection initialized? */
 	int outbox;      /**< Output mailbox for requests.   */
 	int outportal;   /**< Output portal for data.        */
+	int allocated;   /**< Were blocks allocated?         */
+	size_t blksize;  /**< Block size (in bytes).         */
+	rpage_t nblocks; /**< Capacity (in blocks).          */
+	rpage_t nfree;   /**< Free blocks (last reported).   */
+	int posted;      /**< Were writes posted?            */
 } server[RMEM_SERVERS_NUM] = {
-	[0 ... (RMEM_SERVERS_NUM - 1)] = { 0, -1, -1 }
+	[0 ... (RMEM_SERVERS_NUM - 1)] = { 0, -1, -1, 0, 0, 0, 0, 0 }
 };
 
+/**
+ * @brief Number of successful allocation requests.
+ */
+static unsigned nallocs = 0;
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Bounce buffer for vectored operations.
+ */
+static char iobuf[RMEM_IOV_MAX*RMEM_BLOCK_SIZE];
+
+/**
+ * @brief Bounce buffer for reads with blocks pushed ahead.
+ *
+ * Data of asynchronous reads may be received while a vectored
+ * operation is using @p iobuf, thus it gets a buffer of its own.
+ */
+static char pushbuf[(RMEM_PREFETCH_MAX + 1)*RMEM_BLOCK_SIZE];
+
+#endif
+
+/**
+ * @brief Length of the forwarding table (must be a power of two).
+ */
+#define RMEM_FORWARDS_LENGTH 256
+
+/**
+ * @brief Tombstone of the forwarding table.
+ */
+#define RMEM_FORWARD_DELETED ((rpage_t) -1)
+
+/**
+ * @brief Forwarding table of migrated blocks.
+ *
+ * Blocks that are migrated keep their original number, which is
+ * redirected to their current location through this table.
+ */
+static struct
+{
+	rpage_t from; /**< Original block number (null if unused). */
+	rpage_t to;   /**< Current block number.                   */
+} forwards[RMEM_FORWARDS_LENGTH];
+
+/**
+ * @brief Number of entries in the forwarding table.
+ */
+static int nforwards = 0;
+
+/**
+ * @brief Buffer for migrations.
+ */
+static char migbuf[RMEM_BLOCK_SIZE];
+
+/**
+ * @brief Maximum number of outstanding asynchronous requests.
+ */
+#define RMEM_PENDING_MAX 16
+
+/**
+ * @brief Mask of tags of asynchronous requests.
+ */
+#define RMEM_TAG_MASK 0x7fffffff
+
+/**
+ * @name States of asynchronous requests
+ */
+/**@{*/
+#define RMEM_PENDING_FREE     0 /**< Unused.                  */
+#define RMEM_PENDING_ISSUED   1 /**< Waiting for data/reply.  */
+#define RMEM_PENDING_RECEIVED 2 /**< Waiting for reply.       */
+#define RMEM_PENDING_DONE     3 /**< Completed.               */
+/**@}*/
+
+/**
+ * @brief Outstanding asynchronous requests.
+ */
+static struct
+{
+	int state;    /**< State.                       */
+	uint32_t tag; /**< Tag.                         */
+	int serverid; /**< Target server.               */
+	void *buf;    /**< Target buffer (reads only).  */
+	int errcode;  /**< Error code.                  */
+} pending[RMEM_PENDING_MAX];
+
+/**
+ * @brief Last tag that was handed out.
+ */
+static uint32_t lasttag = RMEM_TAG_NONE;
+
+/**
+ * @brief Blocks that were pushed ahead of reads by servers.
+ */
+static struct
+{
+	rpage_t blknum;             /**< Block number (null if unused). */
+	char data[RMEM_BLOCK_SIZE]; /**< Contents of the block.         */
+} pushed[RMEM_PREFETCH_MAX + 1];
+
+/**
+ * @brief Next entry of the prefetch buffer to be replaced.
+ */
+static int pushed_next = 0;
+
+/**
+ * @brief Prefetch statistics.
+ */
+static struct
+{
+	unsigned npushed; /**< Blocks pushed by servers.     */
+	unsigned nhits;   /**< Pushed blocks that were read. */
+} prefetch_stats = { 0, 0 };
+
+/*============================================================================*
+ * Prefetch Buffer                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Drops a block from the prefetch buffer.
+ *
+ * @param blknum Number of the target block.
+ */
+static void nanvix_rmem_pushed_drop(rpage_t blknum)
+{
+	for (int i = 0; i < (RMEM_PREFETCH_MAX + 1); i++)
+	{
+		if (pushed[i].blknum == blknum)
+			pushed[i].blknum = RMEM_NULL;
+	}
+}
+
+/**
+ * @brief Takes a block from the prefetch buffer.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Location where the block should be written to.
+ *
+ * @returns One if the target block was in the prefetch buffer, and
+ * zero otherwise.
+ */
+static int nanvix_rmem_pushed_take(rpage_t blknum, void *buf)
+{
+	for (int i = 0; i < (RMEM_PREFETCH_MAX + 1); i++)
+	{
+		if (pushed[i].blknum == blknum)
+		{
+			umemcpy(buf, pushed[i].data, RMEM_BLOCK_SIZE);
+			pushed[i].blknum = RMEM_NULL;
+			prefetch_stats.nhits++;
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Puts a block in the prefetch buffer.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Location where the block should be read from.
+ */
+static void nanvix_rmem_pushed_put(rpage_t blknum, const void *buf)
+{
+	nanvix_rmem_pushed_drop(blknum);
+
+	pushed[pushed_next].blknum = blknum;
+	umemcpy(pushed[pushed_next].data, buf, RMEM_BLOCK_SIZE);
+	pushed_next = (pushed_next + 1) % (RMEM_PREFETCH_MAX + 1);
+	prefetch_stats.npushed++;
+}
+
+/*============================================================================*
+ * Forwarding Table                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Hashes a block number into the forwarding table.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns The first slot to probe for the target block.
+ */
+static inline unsigned nanvix_rmem_forward_hash(rpage_t blknum)
+{
+	return ((RMEM_BLOCK_NUM(blknum) ^ RMEM_BLOCK_SERVER(blknum)) & (RMEM_FORWARDS_LENGTH - 1));
+}
+
+/**
+ * @brief Looks up a block in the forwarding table.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns The slot of the target block, or a negative number if it
+ * was not migrated.
+ */
+static int nanvix_rmem_forward_lookup(rpage_t blknum)
+{
+	unsigned slot = nanvix_rmem_forward_hash(blknum);
+
+	for (int i = 0; i < RMEM_FORWARDS_LENGTH; i++)
+	{
+		if (forwards[slot].from == blknum)
+			return (slot);
+
+		if (forwards[slot].from == RMEM_NULL)
+			break;
+
+		slot = (slot + 1) & (RMEM_FORWARDS_LENGTH - 1);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Translates a block number to the current location of the block.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns The number of the block where the contents of the target
+ * block currently live.
+ */
+static inline rpage_t nanvix_rmem_forward(rpage_t blknum)
+{
+	int slot;
+
+	/* Fast path. */
+	if (nforwards == 0)
+		return (blknum);
+
+	slot = nanvix_rmem_forward_lookup(blknum);
+
+	return ((slot < 0) ? blknum : forwards[slot].to);
+}
+
+/**
+ * @brief Redirects a block to a new location.
+ *
+ * @param from Original number of the target block.
+ * @param to   Current number of the target block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_forward_set(rpage_t from, rpage_t to)
+{
+	int slot;
+	int empty = -1;
+	unsigned probe = nanvix_rmem_forward_hash(from);
+
+	/* Update existing entry. */
+	if ((slot = nanvix_rmem_forward_lookup(from)) >= 0)
+	{
+		forwards[slot].to = to;
+		return (0);
+	}
+
+	/* Leave room for lookups to stop. */
+	if (nforwards == (RMEM_FORWARDS_LENGTH - 1))
+		return (-ENOSPC);
+
+	for (int i = 0; i < RMEM_FORWARDS_LENGTH; i++)
+	{
+		if ((forwards[probe].from == RMEM_NULL) || (forwards[probe].from == RMEM_FORWARD_DELETED))
+		{
+			empty = probe;
+			break;
+		}
+
+		probe = (probe + 1) & (RMEM_FORWARDS_LENGTH - 1);
+	}
+
+	uassert(empty >= 0);
+
+	forwards[empty].from = from;
+	forwards[empty].to = to;
+	nforwards++;
+
+	return (0);
+}
+
+/**
+ * @brief Removes a block from the forwarding table.
+ *
+ * @param blknum Original number of the target block.
+ */
+static void nanvix_rmem_forward_clear(rpage_t blknum)
+{
+	int slot;
+
+	if ((slot = nanvix_rmem_forward_lookup(blknum)) < 0)
+		return;
+
+	forwards[slot].from = RMEM_FORWARD_DELETED;
+	forwards[slot].to = RMEM_NULL;
+
+	/* Drop tombstones once the table is empty. */
+	if (--nforwards == 0)
+		umemset(forwards, 0, sizeof(forwards));
+}
+
+/*============================================================================*
+ * nanvix_rmem_blknum_is_valid()                                              *
+ *============================================================================*/
+
+/**
+ * @brief Checks if a block number is valid.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns One if the target block number lies within the capacity of
+ * its server, and zero otherwise.
+ */
+static inline int nanvix_rmem_blknum_is_valid(rpage_t blknum)
+{
+	if (blknum == RMEM_NULL)
+		return (0);
+
+	if (RMEM_BLOCK_SERVER(blknum) >= RMEM_SERVERS_NUM)
+		return (0);
+
+	return (RMEM_BLOCK_NUM(blknum) < server[RMEM_BLOCK_SERVER(blknum)].nblocks);
+}
+
+/*============================================================================*
+ * nanvix_rmem_is_zero()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Checks if a block is all zeros.
+ *
+ * @param buf Location where the block should be read from.
+ *
+ * @returns One if the target block is all zeros, and zero otherwise.
+ */
+static int nanvix_rmem_is_zero(const void *buf)
+{
+	const word_t *words = buf;
+
+	for (size_t i = 0; i < (RMEM_BLOCK_SIZE/sizeof(word_t)); i++)
+	{
+		if (words[i] != 0)
+			return (0);
+	}
+
+	return (1);
+}
+
+/*============================================================================*
+ * Asynchronous Requests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Allocates an entry for an asynchronous request.
+ *
+ * @param serverid ID of the target server.
+ * @param buf      Target buffer (reads only).
+ *
+ * @returns Upon successful completion, the index of the newly
+ * allocated entry is returned. Upon failure, a negative number is
+ * returned instead.
+ */
+static int nanvix_rmem_pending_alloc(int serverid, void *buf)
+{
+	for (int i = 0; i < RMEM_PENDING_MAX; i++)
+	{
+		if (pending[i].state != RMEM_PENDING_FREE)
+			continue;
+
+		/* Tags wrap around, skipping the null tag. */
+		if ((lasttag = (lasttag + 1) & RMEM_TAG_MASK) == RMEM_TAG_NONE)
+			lasttag++;
+
+		pending[i].state = RMEM_PENDING_ISSUED;
+		pending[i].tag = lasttag;
+		pending[i].serverid = serverid;
+		pending[i].buf = buf;
+		pending[i].errcode = 0;
+
+		return (i);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Looks up an asynchronous request.
+ *
+ * @param tag Tag of the target request.
+ *
+ * @returns If the target request is found, the index of its entry is
+ * returned. Otherwise, a negative number is returned instead.
+ */
+static int nanvix_rmem_pending_lookup(uint32_t tag)
+{
+	if (tag == RMEM_TAG_NONE)
+		return (-1);
+
+	for (int i = 0; i < RMEM_PENDING_MAX; i++)
+	{
+		if ((pending[i].state != RMEM_PENDING_FREE) && (pending[i].tag == tag))
+			return (i);
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Completes an asynchronous request.
+ *
+ * @param i       Index of the target request.
+ * @param errcode Error code of the target request.
+ */
+static inline void nanvix_rmem_pending_done(int i, int errcode)
+{
+	pending[i].errcode = errcode;
+	pending[i].state = RMEM_PENDING_DONE;
+}
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Receives the data of a read.
+ *
+ * @param serverid ID of the target server.
+ * @param msg      Acknowledge of the read.
+ * @param buf      Location where the data should be written to.
+ * @param push     Store blocks that were pushed ahead?
+ */
+static void nanvix_rmem_read_data(int serverid, const struct rmem_message *msg, void *buf, int push)
+{
+	/* Zero block. */
+	if (msg->flags & RMEM_FLAG_ZERO)
+		umemset(buf, 0, RMEM_BLOCK_SIZE);
+
+	/* No blocks were pushed. */
+	else if (msg->nblocks == 0)
+	{
+		uassert(
+			kportal_allow(
+				stdinportal_get(),
+				rmem_servers[serverid].nodenum,
+				msg->header.portal_port
+			) == 0
+		);
+		uassert(
+			kportal_read(
+				stdinportal_get(),
+				buf,
+				RMEM_BLOCK_SIZE
+			) == RMEM_BLOCK_SIZE
+		);
+	}
+
+	/* Some blocks were pushed. */
+	else
+	{
+		uassert((msg->nblocks > 0) && (msg->nblocks <= RMEM_PREFETCH_MAX));
+		uassert(
+			kportal_allow(
+				stdinportal_get(),
+				rmem_servers[serverid].nodenum,
+				msg->header.portal_port
+			) == 0
+		);
+		uassert(
+			kportal_read(
+				stdinportal_get(),
+				pushbuf,
+				(msg->nblocks + 1)*RMEM_BLOCK_SIZE
+			) == (msg->nblocks + 1)*RMEM_BLOCK_SIZE
+		);
+
+		umemcpy(buf, pushbuf, RMEM_BLOCK_SIZE);
+		for (int i = 0; (i < msg->nblocks) && push; i++)
+			nanvix_rmem_pushed_put(msg->blknums[i], &pushbuf[(i + 1)*RMEM_BLOCK_SIZE]);
+	}
+}
+
+#endif
+
+/**
+ * @brief Receives a message from a remote memory server.
+ *
+ * Messages that answer asynchronous requests are consumed. Data of
+ * asynchronous reads is received as soon as it is announced, because
+ * servers block until it is. Blocks that were pushed ahead of
+ * asynchronous reads are dropped, as later writes might have made
+ * them stale.
+ *
+ * @param msg Location to store the message.
+ *
+ * @returns Zero if the message answers a synchronous request, and
+ * non-zero otherwise.
+ */
+static int nanvix_rmem_dispatch(struct rmem_message *msg)
+{
+	int i;
+
+	uassert(
+		kmailbox_read(
+			stdinbox_get(),
+			msg,
+			sizeof(struct rmem_message)
+		) == sizeof(struct rmem_message)
+	);
+
+	/* Synchronous request. */
+	if (msg->tag == RMEM_TAG_NONE)
+		return (0);
+
+	uassert((i = nanvix_rmem_pending_lookup(msg->tag)) >= 0);
+
+#ifndef __RMEM_USES_MAILBOX
+	/* Data of a read. */
+	if (msg->header.opcode == RMEM_ACK)
+	{
+		uassert(pending[i].state == RMEM_PENDING_ISSUED);
+		nanvix_rmem_read_data(pending[i].serverid, msg, pending[i].buf, 0);
+		pending[i].state = RMEM_PENDING_RECEIVED;
+		return (1);
+	}
+#endif
+
+	nanvix_rmem_pending_done(i, msg->errcode);
+
+	return (1);
+}
+
+/**
+ * @brief Receives a message that answers a synchronous request.
+ *
+ * @param msg Location to store the message.
+ */
+static void nanvix_rmem_receive(struct rmem_message *msg)
+{
+	while (nanvix_rmem_dispatch(msg))
+		/* noop */;
+}
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Receives the data of asynchronous reads from a server.
+ *
+ * Servers handle the requests of a client in order. Therefore, this
+ * should be called before sending data to a server, otherwise the
+ * server could be blocked sending the data of a read while the
+ * client is blocked sending data.
+ *
+ * @param serverid ID of the target server.
+ */
+static void nanvix_rmem_pending_flush(int serverid)
+{
+	for (int i = 0; i < RMEM_PENDING_MAX; i++)
+	{
+		while ((pending[i].state == RMEM_PENDING_ISSUED) &&
+			(pending[i].serverid == serverid) &&
+			(pending[i].buf != NULL))
+		{
+			struct rmem_message msg;
+
+			uassert(nanvix_rmem_dispatch(&msg));
+		}
+	}
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_write_stream()                                                 *
+ *============================================================================*/
+
+#ifdef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Streams a byte range to a remote block.
+ *
+ * Data is sent in chunks of @p RMEM_PAYLOAD_SIZE bytes, and up to
+ * @p RMEM_WINDOW_LENGTH chunks are kept in flight. The server
+ * acknowledges every half window of chunks cumulatively, unless the
+ * write is posted.
+ *
+ * @param serverid ID of the target server.
+ * @param opcode   Write operation.
+ * @param blknum   Number of the target block.
+ * @param buf      Source buffer.
+ * @param offset   Offset within the target block.
+ * @param n        Number of bytes to write.
+ * @param flags    Flags of the write.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_write_stream(
+	int serverid,
+	int opcode,
+	rpage_t blknum,
+	const char *buf,
+	size_t offset,
+	size_t n,
+	uint32_t flags
+)
+{
+	int ret = 0;
+	int nacks = 0;
+	size_t seq = 0;
+	struct rmem_message msg;
+
+	for (size_t i = 0; i < n; i += RMEM_PAYLOAD_SIZE, seq++)
+	{
+		int last;
+
+		message_header_build2(
+			&msg.header,
+			opcode,
+			nanvix_portal_get_port(server[serverid].outportal)
+		);
+		msg.tag = RMEM_TAG_NONE;
+		msg.blknum = blknum;
+		msg.offset = offset + i;
+		msg.size = ((n - i) < RMEM_PAYLOAD_SIZE) ? (n - i) : RMEM_PAYLOAD_SIZE;
+		msg.flags = flags;
+
+		/* Zero blocks are not transferred. */
+		last = ((i + msg.size) >= n) || (flags & RMEM_FLAG_ZERO);
+
+		/* Posted writes are never acknowledged. */
+		if (!(flags & RMEM_FLAG_POSTED) && (last || (((seq + 1) % (RMEM_WINDOW_LENGTH/2)) == 0)))
+			msg.flags |= RMEM_FLAG_ACK;
+
+		if (!(flags & RMEM_FLAG_ZERO))
+			umemcpy(&msg.payload, &buf[i], msg.size);
+
+		uassert(
+			nanvix_mailbox_write(
+				server[serverid].outbox,
+				&msg, sizeof(struct rmem_message)
+			) == 0
+		);
+
+		if (msg.flags & RMEM_FLAG_ACK)
+			nacks++;
+
+		/* Wait for window to slide. */
+		while ((nacks > 1) || ((nacks > 0) && last))
+		{
+			nanvix_rmem_receive(&msg);
+
+			if ((msg.errcode < 0) && (ret == 0))
+				ret = msg.errcode;
+
+			nacks--;
+		}
+
+		if (last)
+			break;
+	}
+
+	return (ret);
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_alloc()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Picks a remote memory server for an allocation.
+ *
+ * The server that last reported the largest number of free blocks is
+ * chosen. Ties are broken in a round-robin fashion.
+ *
+ * @param tried Mask of servers that should be skipped.
+ *
+ * @returns The ID of the chosen server, or a negative number if
+ * there is none.
+ */
+static int nanvix_rmem_server_pick(unsigned tried)
+{
+	int best = -1;
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		int serverid = (nallocs + i) % RMEM_SERVERS_NUM;
+
+		/* Skip this server. */
+		if ((!server[serverid].initialized) || (tried & (1 << serverid)))
+			continue;
+
+		if ((best < 0) || (server[serverid].nfree > server[best].nfree))
+			best = serverid;
+	}
+
+	return (best);
+}
+
+/**
+ * @brief Allocates a remote memory block in a given server.
+ *
+ * @param serverid ID of the target server.
+ *
+ * @returns Upon successful completion, the number of the newly
+ * allocated block is returned. Upon failure, @p RMEM_NULL is
+ * returned instead.
+ */
+static rpage_t nanvix_rmem_alloc_at(int serverid)
+{
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_ALLOC);
+	msg.tag = RMEM_TAG_NONE;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg, sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	server[serverid].nfree = msg.nfree;
+
+	if (msg.errcode == RMEM_NULL)
+		return RMEM_NULL;
+
+	server[serverid].allocated = 1;
+	return (msg.blknum);
+}
+
+/**
+ * The nanvix_rmem_alloc() function allocates a remote memory block in
+ * the server that has the most free blocks. Other servers are tried
+ * if that one runs out of memory.
+ */
+rpage_t nanvix_rmem_alloc(void)
+{
+	int serverid;
+	unsigned tried = 0;
+	rpage_t blknum;
+
+	while ((serverid = nanvix_rmem_server_pick(tried)) >= 0)
+	{
+		if ((blknum = nanvix_rmem_alloc_at(serverid)) != RMEM_NULL)
+		{
+			nallocs++;
+			return (blknum);
+		}
+
+		/* Server is full, try next one. */
+		tried |= (1 << serverid);
+	}
+
+	return (RMEM_NULL);
+}
+
+/*============================================================================*
+ * nanvix_rmem_free()                                                         *
+ *============================================================================*/
+
+/**
+ * @todo TODO: Provide a detailed description for this function.
+ */
+int nanvix_rmem_free(rpage_t blknum)
+{
+	int ret;
+	int serverid;
+	rpage_t target;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (-EINVAL);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (-EINVAL);
+
+	/* Free current location of a migrated block. */
+	if ((target = nanvix_rmem_forward(blknum)) != blknum)
+	{
+		if ((ret = nanvix_rmem_free(target)) < 0)
+			return (ret);
+		nanvix_rmem_forward_clear(blknum);
+	}
+
+	nanvix_rmem_pushed_drop(blknum);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_MEMFREE);
+	msg.tag = RMEM_TAG_NONE;
+	msg.blknum = blknum;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	server[serverid].nfree = msg.nfree;
+
+	return (msg.errcode);
+}
+
+/*============================================================================*
+ * nanvix_rmem_read()                                                         *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @todo TODO: Provide a detailed description for this function.
+ */
+size_t nanvix_rmem_read(rpage_t blknum, void *buf)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	/* Block was pushed ahead. */
+	if (nanvix_rmem_pushed_take(blknum, buf))
+		return (RMEM_BLOCK_SIZE);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_READ);
+	msg.tag = RMEM_TAG_NONE;
+
+	msg.blknum = blknum;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Wait acknowledge. */
+	nanvix_rmem_receive(&msg);
+	uassert(msg.header.opcode == RMEM_ACK);
+
+	nanvix_rmem_read_data(serverid, &msg, buf, 1);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+}
+
+#else
+
+/**
+ * @todo TODO: Provide a detailed description for this function.
+ */
+size_t nanvix_rmem_read(rpage_t blknum, void *buf)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_READ);
+	msg.tag = RMEM_TAG_NONE;
+
+	msg.blknum = blknum;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	for (size_t i = 0; i < RMEM_BLOCK_SIZE; i += RMEM_PAYLOAD_SIZE)
+	{
+		/* Wait acknowledge. */
+		nanvix_rmem_receive(&msg);
+		uassert(msg.header.opcode == RMEM_ACK);
+
+		/* Zero block. */
+		if (msg.flags & RMEM_FLAG_ZERO)
+		{
+			umemset(buf, 0, RMEM_BLOCK_SIZE);
+			break;
+		}
+
+		umemcpy(&((char *)buf)[i], &msg.payload, RMEM_PAYLOAD_SIZE);
+
+	}
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_write()                                                        *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Writes a block to the remote memory.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Location where the data should be read from.
+ * @param flags  Flags of the write.
+ * @param tag    Tag of the write. The reply to an asynchronous write
+ *               is not waited for.
+ *
+ * @returns Upon successful completion, the number of bytes written
+ * (or issued) is returned. Upon failure, zero is returned instead.
+ */
+static size_t nanvix_rmem_write_block(rpage_t blknum, const void *buf, uint32_t flags, uint32_t tag)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	nanvix_rmem_pushed_drop(blknum);
+	nanvix_rmem_pending_flush(serverid);
+
+	/* Build operation header. */
+	message_header_build2(
+		&msg.header,
+		RMEM_WRITE,
+		nanvix_portal_get_port(server[serverid].outportal)
+	);
+	msg.tag = tag;
+	msg.blknum = blknum;
+	msg.flags = flags | (nanvix_rmem_is_zero(buf) ? RMEM_FLAG_ZERO : 0);
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg, sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Send data. Zero blocks are not transferred. */
+	if (!(msg.flags & RMEM_FLAG_ZERO))
+	{
+		uassert(
+			nanvix_portal_write(
+				server[serverid].outportal,
+				buf,
+				RMEM_BLOCK_SIZE
+			) == RMEM_BLOCK_SIZE
+		);
+	}
+
+	/* Errors are reported by a fence. */
+	if (flags & RMEM_FLAG_POSTED)
+	{
+		server[serverid].posted = 1;
+		return (RMEM_BLOCK_SIZE);
+	}
+
+	/* Reply is waited for later. */
+	if (tag != RMEM_TAG_NONE)
+		return (RMEM_BLOCK_SIZE);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+}
+
+#else
+
+/**
+ * @brief Writes a block to the remote memory.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Location where the data should be read from.
+ * @param flags  Flags of the write.
+ * @param tag    Tag of the write (unused).
+ *
+ * @returns Upon successful completion, the number of bytes written
+ * (or posted) is returned. Upon failure, zero is returned instead.
+ */
+static size_t nanvix_rmem_write_block(rpage_t blknum, const void *buf, uint32_t flags, uint32_t tag)
+{
+	int ret;
+	int zero;
+	int serverid;
+
+	((void) tag);
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	nanvix_rmem_pushed_drop(blknum);
+
+	zero = nanvix_rmem_is_zero(buf);
+
+	if (flags & RMEM_FLAG_POSTED)
+		server[serverid].posted = 1;
+
+	ret = nanvix_rmem_write_stream(
+		serverid,
+		RMEM_WRITE,
+		blknum,
+		buf,
+		0,
+		RMEM_BLOCK_SIZE,
+		flags | (zero ? RMEM_FLAG_ZERO : 0)
+	);
+
+	return ((ret < 0) ? 0 : RMEM_BLOCK_SIZE);
+}
+
+#endif
+
+/**
+ * @todo TODO: Provide a detailed description for this function.
+ */
+size_t nanvix_rmem_write(rpage_t blknum, const void *buf)
+{
+	return (nanvix_rmem_write_block(blknum, buf, 0, RMEM_TAG_NONE));
+}
+
+/*============================================================================*
+ * nanvix_rmem_write_posted()                                                 *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_write_posted() function writes the buffer pointed to
+ * by @p buf into the remote memory block @p blknum, without waiting for
+ * the server to apply it. Errors are reported by nanvix_rmem_fence().
+ */
+size_t nanvix_rmem_write_posted(rpage_t blknum, const void *buf)
+{
+	return (nanvix_rmem_write_block(blknum, buf, RMEM_FLAG_POSTED, RMEM_TAG_NONE));
+}
+
+/*============================================================================*
+ * nanvix_rmem_read_async()                                                   *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_read_async() function issues a read of the remote
+ * block @p blknum into @p buf, and returns without waiting for it.
+ */
+int nanvix_rmem_read_async(rpage_t blknum, void *buf)
+{
+	int i;
+	int serverid;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (-EINVAL);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (-EAGAIN);
+
+	/* Too many outstanding requests. */
+	if ((i = nanvix_rmem_pending_alloc(serverid, buf)) < 0)
+		return (-EBUSY);
+
+#ifndef __RMEM_USES_MAILBOX
+
+	/* Block was pushed ahead. */
+	if (nanvix_rmem_pushed_take(blknum, buf))
+		nanvix_rmem_pending_done(i, 0);
+
+	else
+	{
+		struct rmem_message msg;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_READ);
+		msg.tag = pending[i].tag;
+		msg.blknum = blknum;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[serverid].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+	}
+
+#else
+
+	/* The mailbox transport has no asynchronous requests. */
+	nanvix_rmem_pending_done(i,
+		(nanvix_rmem_read(blknum, buf) == RMEM_BLOCK_SIZE) ? 0 : -EFAULT
+	);
+
+#endif
+
+	return (pending[i].tag);
+}
+
+/*============================================================================*
+ * nanvix_rmem_write_async()                                                  *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_write_async() function issues a write of @p buf to
+ * the remote block @p blknum, and returns without waiting for its
+ * reply.
+ */
+int nanvix_rmem_write_async(rpage_t blknum, const void *buf)
+{
+	int i;
+	int serverid;
+	uint32_t tag;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (-EINVAL);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (-EINVAL);
+
+	serverid = RMEM_BLOCK_SERVER(nanvix_rmem_forward(blknum));
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (-EAGAIN);
+
+	/* Too many outstanding requests. */
+	if ((i = nanvix_rmem_pending_alloc(serverid, NULL)) < 0)
+		return (-EBUSY);
+
+	tag = pending[i].tag;
+
+#ifndef __RMEM_USES_MAILBOX
+	uassert(nanvix_rmem_write_block(blknum, buf, 0, tag) == RMEM_BLOCK_SIZE);
+#else
+	/* The mailbox transport has no asynchronous requests. */
+	nanvix_rmem_pending_done(i,
+		(nanvix_rmem_write_block(blknum, buf, 0, tag) == RMEM_BLOCK_SIZE) ? 0 : -EFAULT
+	);
+#endif
+
+	return (tag);
+}
+
+/*============================================================================*
+ * nanvix_rmem_wait()                                                         *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_wait() function waits for the asynchronous request
+ * @p tag to complete, and releases it.
+ */
+int nanvix_rmem_wait(int tag)
+{
+	int i;
+	int ret;
+
+	/* Bad tag. */
+	if ((tag < 0) || ((i = nanvix_rmem_pending_lookup(tag)) < 0))
+		return (-EINVAL);
+
+	while (pending[i].state != RMEM_PENDING_DONE)
+	{
+		struct rmem_message msg;
+
+		uassert(nanvix_rmem_dispatch(&msg));
+	}
+
+	ret = pending[i].errcode;
+	pending[i].state = RMEM_PENDING_FREE;
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_rmem_poll()                                                         *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_poll() function checks whether the asynchronous
+ * request @p tag has completed, without blocking.
+ */
+int nanvix_rmem_poll(int tag)
+{
+	int i;
+
+	/* Bad tag. */
+	if ((tag < 0) || ((i = nanvix_rmem_pending_lookup(tag)) < 0))
+		return (-EINVAL);
+
+	return (pending[i].state == RMEM_PENDING_DONE);
+}
+
+/*============================================================================*
+ * nanvix_rmem_read_partial()                                                 *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Reads a byte range of a remote block.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Target buffer.
+ * @param offset Offset within the target block.
+ * @param n      Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, zero is returned instead.
+ */
+size_t nanvix_rmem_read_partial(rpage_t blknum, void *buf, size_t offset, size_t n)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_READ_PARTIAL);
+	msg.tag = RMEM_TAG_NONE;
+
+	msg.blknum = blknum;
+	msg.offset = offset;
+	msg.size = n;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Wait acknowledge. */
+	nanvix_rmem_receive(&msg);
+	uassert(msg.header.opcode == RMEM_ACK);
+
+	/* Zero block. */
+	if (msg.flags & RMEM_FLAG_ZERO)
+		umemset(buf, 0, n);
+
+	/* Receive data. */
+	else
+	{
+		uassert(
+			kportal_allow(
+				stdinportal_get(),
+				rmem_servers[serverid].nodenum,
+				msg.header.portal_port
+			) == 0
+		);
+		uassert(
+			kportal_read(
+				stdinportal_get(),
+				buf,
+				n
+			) == (ssize_t) n
+		);
+	}
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : n);
+}
+
+#else
+
+/**
+ * @brief Reads a byte range of a remote block.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Target buffer.
+ * @param offset Offset within the target block.
+ * @param n      Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, zero is returned instead.
+ */
+size_t nanvix_rmem_read_partial(rpage_t blknum, void *buf, size_t offset, size_t n)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_READ_PARTIAL);
+	msg.tag = RMEM_TAG_NONE;
+
+	msg.blknum = blknum;
+	msg.offset = offset;
+	msg.size = n;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	for (size_t i = 0; i < n; i += RMEM_PAYLOAD_SIZE)
+	{
+		/* Wait acknowledge. */
+		nanvix_rmem_receive(&msg);
+		uassert(msg.header.opcode == RMEM_ACK);
+
+		/* Zero block. */
+		if (msg.flags & RMEM_FLAG_ZERO)
+		{
+			umemset(buf, 0, n);
+			break;
+		}
+
+		umemcpy(&((char *)buf)[msg.offset - offset], &msg.payload, msg.size);
+	}
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : n);
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_write_partial()                                                *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Writes a byte range of a remote block.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Source buffer.
+ * @param offset Offset within the target block.
+ * @param n      Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, zero is returned instead.
+ */
+size_t nanvix_rmem_write_partial(rpage_t blknum, const void *buf, size_t offset, size_t n)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	nanvix_rmem_pushed_drop(blknum);
+	nanvix_rmem_pending_flush(serverid);
+
+	/* Build operation header. */
+	message_header_build2(
+		&msg.header,
+		RMEM_WRITE_PARTIAL,
+		nanvix_portal_get_port(server[serverid].outportal)
+	);
+	msg.tag = RMEM_TAG_NONE;
+	msg.blknum = blknum;
+	msg.offset = offset;
+	msg.size = n;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg, sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Send data. */
+	uassert(
+		nanvix_portal_write(
+			server[serverid].outportal,
+			buf,
+			n
+		) == (int) n
+	);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return ((msg.errcode < 0) ? 0 : n);
+}
+
+#else
+
+/**
+ * @brief Writes a byte range of a remote block.
+ *
+ * @param blknum Number of the target block.
+ * @param buf    Source buffer.
+ * @param offset Offset within the target block.
+ * @param n      Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, zero is returned instead.
+ */
+size_t nanvix_rmem_write_partial(rpage_t blknum, const void *buf, size_t offset, size_t n)
+{
+	int ret;
+	int serverid;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (0);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid buffer. */
+	if (buf == NULL)
+		return (0);
+
+	/* Invalid range. */
+	if ((n == 0) || (offset >= RMEM_BLOCK_SIZE) || (n > (RMEM_BLOCK_SIZE - offset)))
+		return (0);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (0);
+
+	nanvix_rmem_pushed_drop(blknum);
+
+	ret = nanvix_rmem_write_stream(
+		serverid,
+		RMEM_WRITE_PARTIAL,
+		blknum,
+		buf,
+		offset,
+		n,
+		0
+	);
+
+	return ((ret < 0) ? 0 : n);
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_iov()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Checks if a list of blocks is valid.
+ *
+ * @param blknums Numbers of the target blocks.
+ * @param bufs    Target buffers.
+ * @param n       Number of blocks.
+ *
+ * @returns Non-zero if the list is valid and zero otherwise.
+ */
+static int nanvix_rmem_iov_is_valid(const rpage_t *blknums, const void *bufs, int n)
+{
+	/* Invalid list. */
+	if ((blknums == NULL) || (bufs == NULL) || (n < 0))
+		return (0);
+
+	for (int i = 0; i < n; i++)
+	{
+		/* Invalid block number. */
+		if (!nanvix_rmem_blknum_is_valid(blknums[i]))
+			return (0);
+
+		/* Client not initialized.  */
+		if (!server[RMEM_BLOCK_SERVER(blknums[i])].initialized)
+			return (0);
+	}
+
+	return (1);
+}
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Reads a batch of blocks from a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be written to.
+ * @param nblocks  Number of blocks.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_readv_batch(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks
+)
+{
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_READV);
+	msg.tag = RMEM_TAG_NONE;
+
+	for (int i = 0; i < nblocks; i++)
+		msg.blknums[i] = blknums[i];
+	msg.nblocks = nblocks;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Wait acknowledge. */
+	nanvix_rmem_receive(&msg);
+	uassert(msg.header.opcode == RMEM_ACK);
+
+	/* Receive data. */
+	uassert(
+		kportal_allow(
+			stdinportal_get(),
+			rmem_servers[serverid].nodenum,
+			msg.header.portal_port
+		) == 0
+	);
+	uassert(
+		kportal_read(
+			stdinportal_get(),
+			iobuf,
+			nblocks*RMEM_BLOCK_SIZE
+		) == (ssize_t) (nblocks*RMEM_BLOCK_SIZE)
+	);
+
+	/*
+	 * Scatter blocks before waiting for the reply, since data of
+	 * asynchronous reads may be received meanwhile.
+	 */
+	for (int i = 0; i < nblocks; i++)
+		umemcpy(bufs[i], &iobuf[i*RMEM_BLOCK_SIZE], RMEM_BLOCK_SIZE);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return (msg.errcode);
+}
+
+/**
+ * @brief Writes a batch of blocks to a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be read from.
+ * @param nblocks  Number of blocks.
+ * @param flags    Flags of the write.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_writev_batch_flags(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks,
+	uint32_t flags
+)
+{
+	struct rmem_message msg;
+
+	nanvix_rmem_pending_flush(serverid);
+
+	/* Gather blocks. */
+	for (int i = 0; i < nblocks; i++)
+		umemcpy(&iobuf[i*RMEM_BLOCK_SIZE], bufs[i], RMEM_BLOCK_SIZE);
+
+	/* Build operation header. */
+	message_header_build2(
+		&msg.header,
+		RMEM_WRITEV,
+		nanvix_portal_get_port(server[serverid].outportal)
+	);
+	msg.tag = RMEM_TAG_NONE;
+
+	for (int i = 0; i < nblocks; i++)
+		msg.blknums[i] = blknums[i];
+	msg.nblocks = nblocks;
+	msg.flags = flags;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg, sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Send data. */
+	uassert(
+		nanvix_portal_write(
+			server[serverid].outportal,
+			iobuf,
+			nblocks*RMEM_BLOCK_SIZE
+		) == (ssize_t) (nblocks*RMEM_BLOCK_SIZE)
+	);
+
+	/* Errors are reported by a fence. */
+	if (flags & RMEM_FLAG_POSTED)
+	{
+		server[serverid].posted = 1;
+		return (0);
+	}
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	return (msg.errcode);
+}
+
+#else
+
+/**
+ * @brief Reads a batch of blocks from a remote memory server.
+ *
+ * @param serverid ID of the target server (unused).
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be written to.
+ * @param nblocks  Number of blocks.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note The mailbox transport has no vectored operations.
+ */
+static int nanvix_rmem_readv_batch(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks
+)
+{
+	((void) serverid);
+
+	for (int i = 0; i < nblocks; i++)
+	{
+		if (nanvix_rmem_read(blknums[i], bufs[i]) != RMEM_BLOCK_SIZE)
+			return (-EFAULT);
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Writes a batch of blocks to a remote memory server.
+ *
+ * @param serverid ID of the target server (unused).
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be read from.
+ * @param nblocks  Number of blocks.
+ * @param flags    Flags of the write.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note The mailbox transport has no vectored operations.
+ */
+static int nanvix_rmem_writev_batch_flags(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks,
+	uint32_t flags
+)
+{
+	((void) serverid);
+
+	for (int i = 0; i < nblocks; i++)
+	{
+		if (nanvix_rmem_write_block(blknums[i], bufs[i], flags, RMEM_TAG_NONE) != RMEM_BLOCK_SIZE)
+			return (-EFAULT);
+	}
+
+	return (0);
+}
+
+#endif
+
+/**
+ * @brief Writes a batch of blocks to a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be read from.
+ * @param nblocks  Number of blocks.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_writev_batch(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks
+)
+{
+	return (nanvix_rmem_writev_batch_flags(serverid, blknums, bufs, nblocks, 0));
+}
+
+/**
+ * @brief Posts a batch of blocks to a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param blknums  Numbers of the target blocks.
+ * @param bufs     Locations where the blocks should be read from.
+ * @param nblocks  Number of blocks.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_writev_posted_batch(
+	int serverid,
+	const rpage_t *blknums,
+	void * const *bufs,
+	int nblocks
+)
+{
+	return (nanvix_rmem_writev_batch_flags(serverid, blknums, bufs, nblocks, RMEM_FLAG_POSTED));
+}
+
+/**
+ * @brief Transfers many blocks from/to remote memory.
+ *
+ * Blocks are grouped by the server where they currently live, in
+ * batches of up to @p RMEM_IOV_MAX blocks, and each batch is
+ * transferred in a single round-trip.
+ *
+ * @param blknums Numbers of the target blocks.
+ * @param bufs    Target buffers.
+ * @param n       Number of blocks.
+ * @param batch   Batch transfer function.
+ *
+ * @returns Upon successful completion, the number of bytes
+ * transferred is returned. Upon failure, zero is returned instead.
+ */
+static size_t nanvix_rmem_iov(
+	const rpage_t *blknums,
+	void * const *bufs,
+	int n,
+	int (*batch)(int, const rpage_t *, void * const *, int)
+)
+{
+	int ret = 0;
+
+	for (int serverid = 0; serverid < RMEM_SERVERS_NUM; serverid++)
+	{
+		int nblocks = 0;
+		void *_bufs[RMEM_IOV_MAX];
+		rpage_t _blknums[RMEM_IOV_MAX];
+
+		for (int i = 0; i < n; i++)
+		{
+			rpage_t blknum = nanvix_rmem_forward(blknums[i]);
+
+			/* Not in this server. */
+			if (RMEM_BLOCK_SERVER(blknum) != (rpage_t) serverid)
+				continue;
+
+			_blknums[nblocks] = blknum;
+			_bufs[nblocks] = bufs[i];
+
+			/* Batch is full. */
+			if (++nblocks == RMEM_IOV_MAX)
+			{
+				if (batch(serverid, _blknums, _bufs, nblocks) < 0)
+					ret = -EFAULT;
+				nblocks = 0;
+			}
+		}
+
+		/* Flush last batch. */
+		if (nblocks > 0)
+		{
+			if (batch(serverid, _blknums, _bufs, nblocks) < 0)
+				ret = -EFAULT;
+		}
+	}
+
+	return ((ret < 0) ? 0 : (size_t) n*RMEM_BLOCK_SIZE);
+}
+
+/*============================================================================*
+ * nanvix_rmem_readv()                                                        *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_readv() function reads the @p n remote memory blocks
+ * listed in @p blknums into the buffers pointed to by @p bufs.
+ */
+size_t nanvix_rmem_readv(const rpage_t *blknums, void * const *bufs, int n)
+{
+	/* Invalid list of blocks. */
+	if (!nanvix_rmem_iov_is_valid(blknums, bufs, n))
+		return (0);
+
+	for (int i = 0; i < n; i++)
+	{
+		/* Invalid buffer. */
+		if (bufs[i] == NULL)
+			return (0);
+	}
+
+	return (nanvix_rmem_iov(blknums, bufs, n, nanvix_rmem_readv_batch));
+}
+
+/*============================================================================*
+ * nanvix_rmem_writev()                                                       *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_writev() function writes the buffers pointed to by
+ * @p bufs into the @p n remote memory blocks listed in @p blknums.
+ */
+size_t nanvix_rmem_writev(const rpage_t *blknums, const void * const *bufs, int n)
+{
+	/* Invalid list of blocks. */
+	if (!nanvix_rmem_iov_is_valid(blknums, bufs, n))
+		return (0);
+
+	for (int i = 0; i < n; i++)
+	{
+		/* Invalid buffer. */
+		if (bufs[i] == NULL)
+			return (0);
+	}
+
+	for (int i = 0; i < n; i++)
+		nanvix_rmem_pushed_drop(nanvix_rmem_forward(blknums[i]));
+
+	/* Buffers are only read from. */
+	return (nanvix_rmem_iov(blknums, (void * const *) bufs, n, nanvix_rmem_writev_batch));
+}
+
+/*============================================================================*
+ * nanvix_rmem_writev_posted()                                                *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_writev_posted() function writes the buffers pointed
+ * to by @p bufs into the @p n remote memory blocks listed in
+ * @p blknums, without waiting for servers to apply them. Errors are
+ * reported by nanvix_rmem_fence().
+ */
+size_t nanvix_rmem_writev_posted(const rpage_t *blknums, const void * const *bufs, int n)
+{
+	/* Invalid list of blocks. */
+	if (!nanvix_rmem_iov_is_valid(blknums, bufs, n))
+		return (0);
+
+	for (int i = 0; i < n; i++)
+	{
+		/* Invalid buffer. */
+		if (bufs[i] == NULL)
+			return (0);
+	}
+
+	for (int i = 0; i < n; i++)
+		nanvix_rmem_pushed_drop(nanvix_rmem_forward(blknums[i]));
+
+	/* Buffers are only read from. */
+	return (nanvix_rmem_iov(blknums, (void * const *) bufs, n, nanvix_rmem_writev_posted_batch));
+}
+
+/*============================================================================*
+ * nanvix_rmem_fence()                                                        *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_fence() function waits until all writes that were
+ * posted by the calling process are applied by remote memory servers.
+ * Only servers to which writes were posted since the last fence are
+ * contacted.
+ */
+int nanvix_rmem_fence(void)
+{
+	int ret = 0;
+	struct rmem_message msg;
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		/* Nothing to do. */
+		if ((!server[i].initialized) || (!server[i].posted))
+			continue;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_FENCE);
+		msg.tag = RMEM_TAG_NONE;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[i].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		server[i].posted = 0;
+
+		if ((msg.errcode < 0) && (ret == 0))
+			ret = msg.errcode;
+	}
+
+	return (ret);
+}
+
+/*============================================================================*
+ * nanvix_rmem_atomic()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Runs an atomic operation on a word of a remote block.
+ *
+ * @param opcode   Atomic operation.
+ * @param blknum   Number of the target block.
+ * @param offset   Offset of the target word within the target block.
+ * @param value    Operand.
+ * @param expected Expected value (compare-and-swap only).
+ * @param old      Location to store the previous value of the word.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_atomic(
+	int opcode,
+	rpage_t blknum,
+	size_t offset,
+	uint64_t value,
+	uint64_t expected,
+	uint64_t *old
+)
+{
+	int serverid;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (-EINVAL);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
+
+	/* Invalid word. */
+	if ((offset >= RMEM_BLOCK_SIZE) || ((offset % sizeof(uint64_t)) != 0))
+		return (-EINVAL);
+
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (-EINVAL);
+
+	nanvix_rmem_pushed_drop(blknum);
+
+	/* Build operation header. */
+	message_header_build(&msg.header, opcode);
+	msg.tag = RMEM_TAG_NONE;
+	msg.blknum = blknum;
+	msg.offset = offset;
+	msg.atomic.value = value;
+	msg.atomic.expected = expected;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	if (msg.errcode < 0)
+		return (msg.errcode);
+
+	if (old != NULL)
+		*old = msg.atomic.value;
+
+	return (0);
+}
+
+/**
+ * The nanvix_rmem_fetch_add() function atomically adds @p value to the
+ * word at @p offset of the remote memory block @p blknum.
+ */
+int nanvix_rmem_fetch_add(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old)
+{
+	return (nanvix_rmem_atomic(RMEM_ATOMIC_ADD, blknum, offset, value, 0, old));
+}
+
+/**
+ * The nanvix_rmem_compare_swap() function atomically sets to
+ * @p desired the word at @p offset of the remote memory block
+ * @p blknum, if it equals @p expected.
+ */
+int nanvix_rmem_compare_swap(rpage_t blknum, size_t offset, uint64_t expected, uint64_t desired, uint64_t *old)
+{
+	return (nanvix_rmem_atomic(RMEM_ATOMIC_CAS, blknum, offset, desired, expected, old));
+}
+
+/**
+ * The nanvix_rmem_swap() function atomically sets to @p value the word
+ * at @p offset of the remote memory block @p blknum.
+ */
+int nanvix_rmem_swap(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old)
+{
+	return (nanvix_rmem_atomic(RMEM_ATOMIC_SWAP, blknum, offset, value, 0, old));
+}
+
+/**
+ * The nanvix_rmem_fetch_or() function atomically ORs @p value into the
+ * word at @p offset of the remote memory block @p blknum.
+ */
+int nanvix_rmem_fetch_or(rpage_t blknum, size_t offset, uint64_t value, uint64_t *old)
+{
+	return (nanvix_rmem_atomic(RMEM_ATOMIC_OR, blknum, offset, value, 0, old));
+}
+
 /*============================================================================*
- * nanvix_rmem_alloc()                                                        *
+ * nanvix_rmem_alloc_n()                                                      *
  *============================================================================*/
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_alloc_n() function allocates @p n remote memory
+ * blocks and stores their numbers in @p blknums. Blocks are requested
+ * in bulk from the server that has the most free blocks, which returns
+ * them as extents, and other servers are tried if that one runs out of
+ * memory.
  */
-rpage_t nanvix_rmem_alloc(void)
+int nanvix_rmem_alloc_n(rpage_t *blknums, int n)
 {
-	int serverid;
-	static unsigned nallocs = 0;
-	struct rmem_message msg;
+	int nallocated = 0;
 
-	serverid = nallocs % RMEM_SERVERS_NUM;
+	/* Invalid arguments. */
+	if ((blknums == NULL) || (n <= 0))
+		return (-EINVAL);
 
-	/* Client not initialized.  */
-	if (!server[serverid].initialized)
-		return (RMEM_NULL);
+	for (unsigned tried = 0; nallocated < n; /* noop */)
+	{
+		int serverid;
+		struct rmem_message msg;
+
+		/* No server left. */
+		if ((serverid = nanvix_rmem_server_pick(tried)) < 0)
+			break;
 
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_ALLOC_N);
+		msg.tag = RMEM_TAG_NONE;
+		msg.nblocks = n - nallocated;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[serverid].outbox,
+				&msg, sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		server[serverid].nfree = msg.nfree;
+
+		/* Server is full, try next one. */
+		if (msg.errcode <= 0)
+		{
+			tried |= (1 << serverid);
+			continue;
+		}
+
+		server[serverid].allocated = 1;
+
+		/* Unpack extents. */
+		for (int i = 0; i < msg.nblocks; i++)
+		{
+			for (rpage_t j = 0; j < RMEM_EXTENT_COUNT(&msg, i); j++)
+				blknums[nallocated++] = RMEM_EXTENT_START(&msg, i) + j;
+		}
+	}
+
+	/* Not enough memory. */
+	if (nallocated < n)
+	{
+		if (nallocated > 0)
+			nanvix_rmem_free_n(blknums, nallocated);
+		return (-ENOMEM);
+	}
+
+	nallocs++;
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_rmem_free_n()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Frees a list of extents in a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param msg      Request that carries the list of extents.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_free_extents(int serverid, struct rmem_message *msg)
+{
 	/* Build operation header. */
-	message_header_build(&msg.header, RMEM_ALLOC);
+	message_header_build(&msg->header, RMEM_FREE_N);
+	msg->tag = RMEM_TAG_NONE;
 
 	/* Send operation header. */
 	uassert(
 		nanvix_mailbox_write(
 			server[serverid].outbox,
-			&msg, sizeof(struct rmem_message)
+			msg,
+			sizeof(struct rmem_message)
 		) == 0
 	);
 
 	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_rmem_receive(msg);
 
-	if (msg.errcode == RMEM_NULL)
-		return RMEM_NULL;
+	server[serverid].nfree = msg->nfree;
 
-	nallocs++;
-	return (msg.blknum);
+	return (msg->errcode);
+}
+
+/**
+ * The nanvix_rmem_free_n() function frees the @p n remote memory
+ * blocks listed in @p blknums. Consecutive blocks are freed as
+ * extents, many extents at once.
+ */
+int nanvix_rmem_free_n(const rpage_t *blknums, int n)
+{
+	int err;
+	int ret = 0;
+	int serverid = -1;
+	struct rmem_message msg;
+
+	/* Invalid list of blocks. */
+	if (!nanvix_rmem_iov_is_valid(blknums, blknums, n))
+		return (-EINVAL);
+
+	for (int i = 0; i < n; i++)
+	{
+		rpage_t target;
+
+		/* Free current location of a migrated block. */
+		if ((target = nanvix_rmem_forward(blknums[i])) != blknums[i])
+		{
+			if (((err = nanvix_rmem_free(target)) < 0) && (ret == 0))
+				ret = err;
+			nanvix_rmem_forward_clear(blknums[i]);
+		}
+
+		nanvix_rmem_pushed_drop(blknums[i]);
+	}
+
+	msg.nblocks = 0;
+	for (int i = 0; i < n; /* noop */)
+	{
+		int len = 1;
+
+		/* Measure extent. */
+		while (((i + len) < n) && (blknums[i + len] == (blknums[i] + len)))
+			len++;
+
+		/* Flush extents. */
+		if ((msg.nblocks == RMEM_EXTENTS_MAX) ||
+			((msg.nblocks > 0) && (serverid != (int) RMEM_BLOCK_SERVER(blknums[i]))))
+		{
+			if (((err = nanvix_rmem_free_extents(serverid, &msg)) < 0) && (ret == 0))
+				ret = err;
+			msg.nblocks = 0;
+		}
+
+		serverid = RMEM_BLOCK_SERVER(blknums[i]);
+		RMEM_EXTENT_START(&msg, msg.nblocks) = blknums[i];
+		RMEM_EXTENT_COUNT(&msg, msg.nblocks) = len;
+		msg.nblocks++;
+
+		i += len;
+	}
+
+	/* Flush last extents. */
+	if (msg.nblocks > 0)
+	{
+		if (((err = nanvix_rmem_free_extents(serverid, &msg)) < 0) && (ret == 0))
+			ret = err;
+	}
+
+	return (ret);
 }
 
 /*============================================================================*
- * nanvix_rmem_free()                                                         *
+ * nanvix_rmem_clone()                                                        *
  *============================================================================*/
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_clone() function clones the remote memory block
+ * @p blknum. The clone lives in the same server as the source block,
+ * and it shares its contents until either of them is written.
  */
-int nanvix_rmem_free(rpage_t blknum)
+rpage_t nanvix_rmem_clone(rpage_t blknum)
 {
 	int serverid;
 	struct rmem_message msg;
 
 	/* Invalid block number. */
-	if ((blknum == RMEM_NULL) || (RMEM_BLOCK_NUM(blknum) >= RMEM_NUM_BLOCKS))
-		return (-EINVAL);
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (RMEM_NULL);
+
+	/* Block was migrated. */
+	blknum = nanvix_rmem_forward(blknum);
 
 	serverid = RMEM_BLOCK_SERVER(blknum);
 
 	/* Client not initialized.  */
 	if (!server[serverid].initialized)
-		return (-EINVAL);
+		return (RMEM_NULL);
 
 	/* Build operation header. */
-	message_header_build(&msg.header, RMEM_MEMFREE);
+	message_header_build(&msg.header, RMEM_CLONE);
+	msg.tag = RMEM_TAG_NONE;
 	msg.blknum = blknum;
 
 	/* Send operation header. */
@@ -128,49 +2455,310 @@ int nanvix_rmem_free(rpage_t blknum)
 	);
 
 	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_rmem_receive(&msg);
+
+	server[serverid].nfree = msg.nfree;
+
+	if (msg.errcode < 0)
+		return (RMEM_NULL);
+
+	server[serverid].allocated = 1;
+	nallocs++;
+	return (msg.blknum);
+}
+
+/*============================================================================*
+ * nanvix_rmem_free_all()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_free_all() function frees all remote memory blocks
+ * that are owned by the calling process, issuing a single request to
+ * each server in which blocks were allocated.
+ */
+int nanvix_rmem_free_all(void)
+{
+	int nfreed = 0;
+	struct rmem_message msg;
+
+	/* Drop all pushed blocks. */
+	for (int i = 0; i < (RMEM_PREFETCH_MAX + 1); i++)
+		pushed[i].blknum = RMEM_NULL;
+
+	/* Drop all forwards. */
+	umemset(forwards, 0, sizeof(forwards));
+	nforwards = 0;
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		/* Nothing to do. */
+		if ((!server[i].initialized) || (!server[i].allocated))
+			continue;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_FREE_ALL);
+		msg.tag = RMEM_TAG_NONE;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[i].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		server[i].nfree = msg.nfree;
+
+		if (msg.errcode < 0)
+			return (msg.errcode);
+
+		server[i].allocated = 0;
+		nfreed += msg.nblocks;
+	}
+
+	return (nfreed);
+}
+
+/*============================================================================*
+ * nanvix_rmem_migrate()                                                      *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_migrate() function moves the contents of the remote
+ * memory block @p blknum to the server @p serverid. The block keeps
+ * its number, which is redirected to the new location.
+ */
+int nanvix_rmem_migrate(rpage_t blknum, int serverid)
+{
+	int ret;
+	rpage_t current;
+	rpage_t target;
+	struct rmem_message msg;
+
+	/* Invalid block number. */
+	if (!nanvix_rmem_blknum_is_valid(blknum))
+		return (-EINVAL);
+
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized || !server[RMEM_BLOCK_SERVER(blknum)].initialized)
+		return (-EINVAL);
+
+	current = nanvix_rmem_forward(blknum);
+
+	/* Nothing to do. */
+	if (RMEM_BLOCK_SERVER(current) == (rpage_t) serverid)
+		return (0);
+
+	/* Forwarding table is full. */
+	if ((current == blknum) && (nforwards == (RMEM_FORWARDS_LENGTH - 1)))
+		return (-ENOSPC);
+
+	/* Copy contents to the new location. */
+	if (nanvix_rmem_read(blknum, migbuf) != RMEM_BLOCK_SIZE)
+		return (-EFAULT);
+	if ((target = nanvix_rmem_alloc_at(serverid)) == RMEM_NULL)
+		return (-ENOMEM);
+	if (nanvix_rmem_write(target, migbuf) != RMEM_BLOCK_SIZE)
+	{
+		nanvix_rmem_free(target);
+		return (-EFAULT);
+	}
+
+	nanvix_rmem_pushed_drop(current);
+
+	/*
+	 * The first time that a block is migrated, its original
+	 * location is released, but its number is kept reserved in
+	 * the origin server until the block is freed. Intermediate
+	 * locations are simply freed.
+	 */
+	if (current == blknum)
+	{
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_MIGRATE);
+		msg.tag = RMEM_TAG_NONE;
+		msg.blknum = blknum;
+		msg.blknums[0] = target;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[RMEM_BLOCK_SERVER(blknum)].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		server[RMEM_BLOCK_SERVER(blknum)].nfree = msg.nfree;
+
+		ret = msg.errcode;
+	}
+	else
+		ret = nanvix_rmem_free(current);
+
+	if (ret < 0)
+	{
+		nanvix_rmem_free(target);
+		return (ret);
+	}
+
+	uassert(nanvix_rmem_forward_set(blknum, target) == 0);
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_rmem_rebalance()                                                    *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_rebalance() function migrates blocks listed in
+ * @p blknums out of the servers that have fewer free blocks, into the
+ * server that has the most free blocks, until free blocks are evenly
+ * spread across servers. Free blocks are those last reported by each
+ * server.
+ */
+int nanvix_rmem_rebalance(const rpage_t *blknums, int n)
+{
+	int ret;
+	int nmigrated = 0;
+
+	/* Invalid list of blocks. */
+	if (!nanvix_rmem_iov_is_valid(blknums, blknums, n))
+		return (-EINVAL);
+
+	for (int i = 0; i < n; i++)
+	{
+		int src;
+		int dst;
+
+		src = RMEM_BLOCK_SERVER(nanvix_rmem_forward(blknums[i]));
+
+		/* Least loaded server. */
+		if ((dst = nanvix_rmem_server_pick(0)) < 0)
+			break;
+
+		/* Not worth it. */
+		if (server[dst].nfree <= (server[src].nfree + 1))
+			continue;
+
+		if ((ret = nanvix_rmem_migrate(blknums[i], dst)) < 0)
+			return (ret);
+
+		nmigrated++;
+	}
+
+	return (nmigrated);
+}
+
+/*============================================================================*
+ * nanvix_rmem_prefetch()                                                     *
+ *============================================================================*/
+
+/**
+ * The nanvix_rmem_prefetch() function sets to @p depth the number of
+ * blocks that remote memory servers push ahead of reads of the calling
+ * process, once they detect a strided access pattern. A zero @p depth
+ * disables prefetching.
+ */
+int nanvix_rmem_prefetch(int depth)
+{
+	struct rmem_message msg;
+
+	/* Invalid depth. */
+	if ((depth < 0) || (depth > RMEM_PREFETCH_MAX))
+		return (-EINVAL);
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		/* Nothing to do. */
+		if (!server[i].initialized)
+			continue;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_PREFETCH);
+		msg.tag = RMEM_TAG_NONE;
+		msg.nblocks = depth;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[i].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		if (msg.errcode < 0)
+			return (msg.errcode);
+	}
 
-	return (msg.errcode);
+	/* Drop blocks of a previous stream. */
+	if (depth == 0)
+	{
+		for (int i = 0; i < (RMEM_PREFETCH_MAX + 1); i++)
+			pushed[i].blknum = RMEM_NULL;
+	}
+
+	return (0);
+}
+
+/**
+ * The nanvix_rmem_prefetch_stats() function stores in @p npushed the
+ * number of blocks that were pushed by remote memory servers, and in
+ * @p nhits the number of those that were read afterwards.
+ */
+void nanvix_rmem_prefetch_stats(unsigned *npushed, unsigned *nhits)
+{
+	if (npushed != NULL)
+		*npushed = prefetch_stats.npushed;
+	if (nhits != NULL)
+		*nhits = prefetch_stats.nhits;
 }
 
 /*============================================================================*
- * nanvix_rmem_read()                                                         *
+ * nanvix_rmem_stats()                                                        *
  *============================================================================*/
 
 #ifndef __RMEM_USES_MAILBOX
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_stats() function queries statistics of the remote
+ * memory server @p serverid and stores them in @p out.
  */
-size_t nanvix_rmem_read(rpage_t blknum, void *buf)
+int nanvix_rmem_stats(int serverid, struct rmem_stats *out)
 {
-	int serverid;
 	struct rmem_message msg;
 
-	/* Invalid block number. */
-	if ((blknum == RMEM_NULL) || (RMEM_BLOCK_NUM(blknum) >= RMEM_NUM_BLOCKS))
-		return (0);
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
 
 	/* Invalid buffer. */
-	if (buf == NULL)
-		return (0);
-
-	serverid = RMEM_BLOCK_SERVER(blknum);
+	if (out == NULL)
+		return (-EINVAL);
 
 	/* Client not initialized.  */
 	if (!server[serverid].initialized)
-		return (0);
+		return (-EAGAIN);
 
 	/* Build operation header. */
-	message_header_build(&msg.header, RMEM_READ);
-
-	msg.blknum = blknum;
+	message_header_build(&msg.header, RMEM_STATS);
+	msg.tag = RMEM_TAG_NONE;
 
 	/* Send operation header. */
 	uassert(
@@ -182,16 +2770,10 @@ size_t nanvix_rmem_read(rpage_t blknum, void *buf)
 	);
 
 	/* Wait acknowledge. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_rmem_receive(&msg);
 	uassert(msg.header.opcode == RMEM_ACK);
 
-	/* Receive data. */
+	/* Receive statistics. */
 	uassert(
 		kportal_allow(
 			stdinportal_get(),
@@ -202,51 +2784,39 @@ size_t nanvix_rmem_read(rpage_t blknum, void *buf)
 	uassert(
 		kportal_read(
 			stdinportal_get(),
-			buf,
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
-	);
-
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
+			out,
+			sizeof(struct rmem_stats)
+		) == (ssize_t) sizeof(struct rmem_stats)
 	);
 
-	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+	return (0);
 }
 
 #else
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_stats() function queries statistics of the remote
+ * memory server @p serverid and stores them in @p out.
  */
-size_t nanvix_rmem_read(rpage_t blknum, void *buf)
+int nanvix_rmem_stats(int serverid, struct rmem_stats *out)
 {
-	int serverid;
 	struct rmem_message msg;
 
-	/* Invalid block number. */
-	if ((blknum == RMEM_NULL) || (RMEM_BLOCK_NUM(blknum) >= RMEM_NUM_BLOCKS))
-		return (0);
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
 
 	/* Invalid buffer. */
-	if (buf == NULL)
-		return (0);
-
-	serverid = RMEM_BLOCK_SERVER(blknum);
+	if (out == NULL)
+		return (-EINVAL);
 
 	/* Client not initialized.  */
 	if (!server[serverid].initialized)
-		return (0);
+		return (-EAGAIN);
 
 	/* Build operation header. */
-	message_header_build(&msg.header, RMEM_READ);
-
-	msg.blknum = blknum;
+	message_header_build(&msg.header, RMEM_STATS);
+	msg.tag = RMEM_TAG_NONE;
 
 	/* Send operation header. */
 	uassert(
@@ -257,77 +2827,172 @@ size_t nanvix_rmem_read(rpage_t blknum, void *buf)
 		) == 0
 	);
 
-	for (size_t i = 0; i < RMEM_BLOCK_SIZE; i += RMEM_PAYLOAD_SIZE)
+	for (size_t i = 0; i < sizeof(struct rmem_stats); i += RMEM_PAYLOAD_SIZE)
 	{
-		/* Wait acknowledge. */
-		uassert(
-			kmailbox_read(
-				stdinbox_get(),
-				&msg,
-				sizeof(struct rmem_message)
-			) == sizeof(struct rmem_message)
-		);
+		/* Receive statistics. */
+		nanvix_rmem_receive(&msg);
 		uassert(msg.header.opcode == RMEM_ACK);
 
-		umemcpy(&((char *)buf)[i], &msg.payload, RMEM_PAYLOAD_SIZE);
-
+		umemcpy(&((char *) out)[msg.offset], &msg.payload, msg.size);
 	}
 
-	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
-
-	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+	return (0);
 }
 
 #endif
 
 /*============================================================================*
- * nanvix_rmem_write()                                                        *
+ * nanvix_rmem_checkpoint()                                                   *
  *============================================================================*/
 
 #ifndef __RMEM_USES_MAILBOX
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_checkpoint() function streams the blocks of the
+ * remote memory server @p serverid that changed since they were last
+ * checkpointed to @p sink, along with their owners. Freed blocks are
+ * reported with @p RMEM_RECORD_FREE as owner.
  */
-size_t nanvix_rmem_write(rpage_t blknum, const void *buf)
+int nanvix_rmem_checkpoint(
+	int serverid,
+	int (*sink)(rpage_t blknum, rpage_t owner, const void *data, void *arg),
+	void *arg
+)
 {
-	int serverid;
+	int ret = 0;
+	rpage_t cursor = RMEM_NULL;
 	struct rmem_message msg;
 
-	/* Invalid block number. */
-	if ((blknum == RMEM_NULL) || (RMEM_BLOCK_NUM(blknum) >= RMEM_NUM_BLOCKS))
-		return (0);
-
-	/* Invalid buffer. */
-	if (buf == NULL)
-		return (0);
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
 
-	serverid = RMEM_BLOCK_SERVER(blknum);
+	/* Invalid sink. */
+	if (sink == NULL)
+		return (-EINVAL);
 
 	/* Client not initialized.  */
 	if (!server[serverid].initialized)
-		return (0);
+		return (-EAGAIN);
+
+	do
+	{
+		int nrecords;
+
+		/* Build operation header. */
+		message_header_build(&msg.header, RMEM_CHECKPOINT);
+		msg.tag = RMEM_TAG_NONE;
+		msg.blknum = cursor;
+
+		/* Send operation header. */
+		uassert(
+			nanvix_mailbox_write(
+				server[serverid].outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == 0
+		);
+
+		/* Wait acknowledge. */
+		nanvix_rmem_receive(&msg);
+		uassert(msg.header.opcode == RMEM_ACK);
+
+		cursor = msg.blknum;
+		nrecords = msg.nblocks;
+
+		/* Receive data. */
+		if (nrecords > 0)
+		{
+			uassert(
+				kportal_allow(
+					stdinportal_get(),
+					rmem_servers[serverid].nodenum,
+					msg.header.portal_port
+				) == 0
+			);
+			uassert(
+				kportal_read(
+					stdinportal_get(),
+					iobuf,
+					nrecords*RMEM_BLOCK_SIZE
+				) == (ssize_t) (nrecords*RMEM_BLOCK_SIZE)
+			);
+		}
+
+		/* Hand records over. */
+		for (int i = 0; (i < nrecords) && (ret == 0); i++)
+		{
+			ret = sink(
+				RMEM_RECORD_BLOCK(&msg, i),
+				RMEM_RECORD_OWNER(&msg, i),
+				&iobuf[i*RMEM_BLOCK_SIZE],
+				arg
+			);
+		}
+
+		/* Receive reply. */
+		nanvix_rmem_receive(&msg);
+
+		if ((ret == 0) && (msg.errcode < 0))
+			ret = msg.errcode;
+	} while ((ret == 0) && (cursor != RMEM_NULL));
+
+	return (ret);
+}
+
+#else
+
+/**
+ * The mailbox transport has no vectored operations, thus checkpoints
+ * are not supported.
+ */
+int nanvix_rmem_checkpoint(
+	int serverid,
+	int (*sink)(rpage_t blknum, rpage_t owner, const void *data, void *arg),
+	void *arg
+)
+{
+	((void) serverid);
+	((void) sink);
+	((void) arg);
+
+	return (-ENOTSUP);
+}
+
+#endif
+
+/*============================================================================*
+ * nanvix_rmem_restore()                                                      *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
 
+/**
+ * @brief Sends a batch of records to a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ * @param msg      Request, which carries the records.
+ * @param nrecords Number of records.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_restore_batch(int serverid, struct rmem_message *msg, int nrecords)
+{
 	/* Build operation header. */
 	message_header_build2(
-		&msg.header,
-		RMEM_WRITE,
+		&msg->header,
+		RMEM_RESTORE,
 		nanvix_portal_get_port(server[serverid].outportal)
 	);
-	msg.blknum = blknum;
+	msg->tag = RMEM_TAG_NONE;
+	msg->nblocks = nrecords;
 
 	/* Send operation header. */
 	uassert(
 		nanvix_mailbox_write(
 			server[serverid].outbox,
-			&msg, sizeof(struct rmem_message)
+			msg, sizeof(struct rmem_message)
 		) == 0
 	);
 
@@ -335,77 +3000,100 @@ size_t nanvix_rmem_write(rpage_t blknum, const void *buf)
 	uassert(
 		nanvix_portal_write(
 			server[serverid].outportal,
-			buf,
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
+			iobuf,
+			nrecords*RMEM_BLOCK_SIZE
+		) == (ssize_t) (nrecords*RMEM_BLOCK_SIZE)
 	);
 
 	/* Receive reply. */
-	uassert(
-		kmailbox_read(
-			stdinbox_get(),
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
+	nanvix_rmem_receive(msg);
 
-	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
-}
+	server[serverid].nfree = msg->nfree;
 
-#else
+	return (msg->errcode);
+}
 
 /**
- * @todo TODO: Provide a detailed description for this function.
+ * The nanvix_rmem_restore() function loads the remote memory server
+ * @p serverid with the records produced by @p source, until it
+ * returns zero. The target server should not have allocated any block
+ * yet.
  */
-size_t nanvix_rmem_write(rpage_t blknum, const void *buf)
+int nanvix_rmem_restore(
+	int serverid,
+	int (*source)(rpage_t *blknum, rpage_t *owner, void *data, void *arg),
+	void *arg
+)
 {
-	int serverid;
+	int ret;
+	int nrecords = 0;
 	struct rmem_message msg;
 
-	/* Invalid block number. */
-	if ((blknum == RMEM_NULL) || (RMEM_BLOCK_NUM(blknum) >= RMEM_NUM_BLOCKS))
-		return (0);
-
-	/* Invalid buffer. */
-	if (buf == NULL)
-		return (0);
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
 
-	serverid = RMEM_BLOCK_SERVER(blknum);
+	/* Invalid source. */
+	if (source == NULL)
+		return (-EINVAL);
 
 	/* Client not initialized.  */
 	if (!server[serverid].initialized)
-		return (0);
+		return (-EAGAIN);
 
-	for (size_t i = 0; i < RMEM_BLOCK_SIZE; i += RMEM_PAYLOAD_SIZE)
-	{
-		message_header_build2(
-			&msg.header,
-			RMEM_WRITE,
-			nanvix_portal_get_port(server[serverid].outportal)
-		);
-		msg.blknum = blknum;
-		msg.offset = i;
+	nanvix_rmem_pending_flush(serverid);
 
-		umemcpy(&msg.payload, &((const char *)buf)[i], RMEM_PAYLOAD_SIZE);
+	while ((ret = source(
+		&RMEM_RECORD_BLOCK(&msg, nrecords),
+		&RMEM_RECORD_OWNER(&msg, nrecords),
+		&iobuf[nrecords*RMEM_BLOCK_SIZE],
+		arg)) > 0)
+	{
+		rpage_t blknum = RMEM_RECORD_BLOCK(&msg, nrecords);
 
-		uassert(
-			nanvix_mailbox_write(
-				server[serverid].outbox,
-				&msg, sizeof(struct rmem_message)
-			) == 0
-		);
+		/* Invalid block number. */
+		if (!nanvix_rmem_blknum_is_valid(blknum) ||
+			(RMEM_BLOCK_NUM(blknum) == RMEM_NULL) ||
+			(RMEM_BLOCK_SERVER(blknum) != (rpage_t) serverid))
+			return (-EINVAL);
 
-		/* Receive reply. */
-		uassert(
-			kmailbox_read(
-				stdinbox_get(),
-				&msg,
-				sizeof(struct rmem_message)
-			) == sizeof(struct rmem_message)
-		);
+		/* Send batch. */
+		if (++nrecords == RMEM_RECORDS_MAX)
+		{
+			if ((ret = nanvix_rmem_restore_batch(serverid, &msg, nrecords)) < 0)
+				return (ret);
+			nrecords = 0;
+		}
 	}
 
-	return ((msg.errcode < 0) ? 0 : RMEM_BLOCK_SIZE);
+	/* Source failed. */
+	if (ret < 0)
+		return (ret);
+
+	/* Send last batch. */
+	if (nrecords > 0)
+		return (nanvix_rmem_restore_batch(serverid, &msg, nrecords));
+
+	return (0);
+}
+
+#else
+
+/**
+ * The mailbox transport has no vectored operations, thus restores
+ * are not supported.
+ */
+int nanvix_rmem_restore(
+	int serverid,
+	int (*source)(rpage_t *blknum, rpage_t *owner, void *data, void *arg),
+	void *arg
+)
+{
+	((void) serverid);
+	((void) source);
+	((void) arg);
+
+	return (-ENOTSUP);
 }
 
 #endif
@@ -423,6 +3111,7 @@ int nanvix_rmem_shutdown(void)
 
 	/* Build operation header. */
 	message_header_build(&msg.header, RMEM_EXIT);
+	msg.tag = RMEM_TAG_NONE;
 
 	/* Broadcast shutdown signal. */
 	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
@@ -433,8 +3122,95 @@ int nanvix_rmem_shutdown(void)
 				&msg, sizeof(struct rmem_message)
 			) == 0
 		);
+
+		/* Blocks are gone with the server. */
+		server[i].allocated = 0;
+	}
+
+	return (0);
+}
+
+/*============================================================================*
+ * nanvix_rmem_geometry()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Queries the geometry of a remote memory server.
+ *
+ * @param serverid ID of the target server.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int nanvix_rmem_geometry_query(int serverid)
+{
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	message_header_build(&msg.header, RMEM_INFO);
+	msg.tag = RMEM_TAG_NONE;
+
+	/* Send operation header. */
+	uassert(
+		nanvix_mailbox_write(
+			server[serverid].outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == 0
+	);
+
+	/* Receive reply. */
+	nanvix_rmem_receive(&msg);
+
+	if (msg.errcode < 0)
+		return (msg.errcode);
+
+	/*
+	 * Pages of the cache and of the virtual memory
+	 * manager are as large as blocks of this build.
+	 */
+	if (msg.size != RMEM_BLOCK_SIZE)
+	{
+		uprintf("[nanvix][rmem] unsupported block size %d", msg.size);
+		return (-ENOTSUP);
+	}
+
+	/* Bad capacity. */
+	if ((msg.nblocks <= 0) || (msg.nblocks > RMEM_NUM_BLOCKS))
+	{
+		uprintf("[nanvix][rmem] unsupported capacity %d", msg.nblocks);
+		return (-ENOTSUP);
 	}
 
+	server[serverid].blksize = msg.size;
+	server[serverid].nblocks = msg.nblocks;
+	server[serverid].nfree = msg.nfree;
+
+	return (0);
+}
+
+/**
+ * The nanvix_rmem_geometry() function queries the block size and the
+ * capacity of the remote memory server @p serverid, as advertised
+ * upon connection.
+ */
+int nanvix_rmem_geometry(int serverid, size_t *blksize, rpage_t *nblocks)
+{
+	/* Invalid server. */
+	if ((serverid < 0) || (serverid >= RMEM_SERVERS_NUM))
+		return (-EINVAL);
+
+	/* Invalid buffers. */
+	if ((blksize == NULL) || (nblocks == NULL))
+		return (-EINVAL);
+
+	/* Client not initialized.  */
+	if (!server[serverid].initialized)
+		return (-EAGAIN);
+
+	*blksize = server[serverid].blksize;
+	*nblocks = server[serverid].nblocks;
+
 	return (0);
 }
 
@@ -447,6 +3223,8 @@ int nanvix_rmem_shutdown(void)
  */
 int __nanvix_rmem_setup(void)
 {
+	int ret;
+
 	/* Open connections to remote memory servers. */
 	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
 	{
@@ -468,6 +3246,13 @@ int __nanvix_rmem_setup(void)
 			return (server[i].outportal);
 		}
 
+		/* Adapt to the geometry of the server. */
+		if ((ret = nanvix_rmem_geometry_query(i)) < 0)
+		{
+			uprintf("[nanvix][rmem] cannot query geometry of server");
+			return (ret);
+		}
+
 		uprintf("[nanvix][rmem] connection with server established");
 		server[i].initialized = 1;
 	}
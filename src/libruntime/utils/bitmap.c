@@ -85,11 +85,8 @@ bitmap_t bitmap_first_free(bitmap_t *bitmap, size_t size)
 		/* Index found. */
 		if (*idx != 0xffffffff)
 		{
-			off = 0;
-
 			/* Find offset. */
-			while (*idx & (0x1 << off))
-				off++;
+			off = __builtin_ctz(~(*idx));
 
 			return (((idx - bitmap) << BITMAP_WORD_SHIFT) + off);
 		}
@@ -0,0 +1,368 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/servers/channel.h>
+#include <nanvix/sys/mailbox.h>
+#include <nanvix/sys/portal.h>
+#include <nanvix/sys/noc.h>
+#include <nanvix/limits.h>
+#include <nanvix/ulib.h>
+#include <posix/errno.h>
+
+/**
+ * @name Types of Channels
+ */
+/**@{*/
+#define CHANNEL_MAILBOX 0 /**< Output mailbox. */
+#define CHANNEL_PORTAL  1 /**< Output portal.  */
+/**@}*/
+
+/**
+ * @brief Reply channel.
+ */
+struct channel
+{
+	int remote;        /**< Remote node.                */
+	int port;          /**< Port in the remote node.    */
+	int fd;            /**< Underlying communicator.    */
+	int busy;          /**< Is it in use?               */
+	unsigned age;      /**< Timestamp of the last use.  */
+};
+
+/**
+ * @brief Table of reply channels.
+ */
+static struct
+{
+	int nusers;                                         /**< Number of users. */
+	unsigned clock;                                     /**< Logical clock.   */
+	spinlock_t lock;                                    /**< Lock.            */
+	struct channel mailboxes[NANVIX_CHANNEL_MAILBOX_MAX]; /**< Output mailboxes. */
+	struct channel portals[NANVIX_CHANNEL_PORTAL_MAX];    /**< Output portals.   */
+} channels;
+
+/*============================================================================*
+ * channel_open()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Opens an underlying communicator.
+ *
+ * @param type   Type of the channel.
+ * @param remote Target remote node.
+ * @param port   Target port in the remote node.
+ *
+ * @returns See kmailbox_open() and kportal_open().
+ */
+static int channel_open(int type, int remote, int port)
+{
+	if (type == CHANNEL_MAILBOX)
+		return (kmailbox_open(remote, port));
+
+	return (kportal_open(knode_get_num(), remote, port));
+}
+
+/*============================================================================*
+ * channel_close()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Closes an underlying communicator.
+ *
+ * @param type Type of the channel.
+ * @param fd   Target communicator.
+ */
+static void channel_close(int type, int fd)
+{
+	if (type == CHANNEL_MAILBOX)
+		uassert(kmailbox_close(fd) == 0);
+	else
+		uassert(kportal_close(fd) == 0);
+}
+
+/*============================================================================*
+ * channel_table()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Gets the table of channels of a given type.
+ *
+ * @param type Type of the channel.
+ * @param n    Location to store the length of the table.
+ *
+ * @returns The table of channels of type @p type.
+ */
+static struct channel *channel_table(int type, int *n)
+{
+	if (type == CHANNEL_MAILBOX)
+	{
+		*n = NANVIX_CHANNEL_MAILBOX_MAX;
+		return (channels.mailboxes);
+	}
+
+	*n = NANVIX_CHANNEL_PORTAL_MAX;
+	return (channels.portals);
+}
+
+/*============================================================================*
+ * channel_get()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Gets a channel to a remote.
+ *
+ * A cached channel to the target remote is reused whenever it is idle.
+ * Otherwise, a new one is opened and cached, possibly reclaiming the
+ * least recently used idle channel. If all channels are busy, an
+ * uncached one is opened, and it is closed when released.
+ *
+ * @param type   Type of the channel.
+ * @param remote Target remote node.
+ * @param port   Target port in the remote node.
+ *
+ * @returns Upon successful completion, the ID of the underlying
+ * communicator is returned. Upon failure, a negative error code is
+ * returned instead.
+ */
+static int channel_get(int type, int remote, int port)
+{
+	int n;
+	int fd;
+	int oldfd;
+	struct channel *table;
+	struct channel *victim = NULL;
+
+	table = channel_table(type, &n);
+
+	spinlock_lock(&channels.lock);
+
+		for (int i = 0; i < n; i++)
+		{
+			/* Skip busy channels. */
+			if (table[i].busy)
+				continue;
+
+			/* Hit. */
+			if ((table[i].fd >= 0) && (table[i].remote == remote) && (table[i].port == port))
+			{
+				table[i].busy = 1;
+				table[i].age = ++channels.clock;
+				fd = table[i].fd;
+				spinlock_unlock(&channels.lock);
+				return (fd);
+			}
+
+			/* Free channels are reclaimed first, then the LRU one. */
+			if (victim == NULL)
+				victim = &table[i];
+			else if (victim->fd >= 0)
+			{
+				if ((table[i].fd < 0) || (table[i].age < victim->age))
+					victim = &table[i];
+			}
+		}
+
+		/* All channels are busy. */
+		if (victim == NULL)
+		{
+			spinlock_unlock(&channels.lock);
+			return (channel_open(type, remote, port));
+		}
+
+		oldfd = victim->fd;
+		victim->remote = remote;
+		victim->port = port;
+		victim->fd = -1;
+		victim->busy = 1;
+		victim->age = ++channels.clock;
+
+	spinlock_unlock(&channels.lock);
+
+	/* Reclaim channel. */
+	if (oldfd >= 0)
+		channel_close(type, oldfd);
+
+	fd = channel_open(type, remote, port);
+
+	spinlock_lock(&channels.lock);
+		victim->fd = fd;
+		victim->busy = (fd >= 0);
+	spinlock_unlock(&channels.lock);
+
+	return (fd);
+}
+
+/*============================================================================*
+ * channel_put()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Releases a channel.
+ *
+ * @param type Type of the channel.
+ * @param fd   ID of the underlying communicator.
+ */
+static void channel_put(int type, int fd)
+{
+	int n;
+	struct channel *table;
+
+	table = channel_table(type, &n);
+
+	spinlock_lock(&channels.lock);
+
+		for (int i = 0; i < n; i++)
+		{
+			/* Found. */
+			if (table[i].busy && (table[i].fd == fd))
+			{
+				table[i].busy = 0;
+				spinlock_unlock(&channels.lock);
+				return;
+			}
+		}
+
+	spinlock_unlock(&channels.lock);
+
+	/* Uncached channel. */
+	channel_close(type, fd);
+}
+
+/*============================================================================*
+ * channel_mailbox_get()                                                      *
+ *============================================================================*/
+
+/**
+ * The channel_mailbox_get() function gets an output mailbox to the
+ * port @p port of the remote node @p remote.
+ */
+int channel_mailbox_get(int remote, int port)
+{
+	return (channel_get(CHANNEL_MAILBOX, remote, port));
+}
+
+/*============================================================================*
+ * channel_mailbox_put()                                                      *
+ *============================================================================*/
+
+/**
+ * The channel_mailbox_put() function releases the output mailbox @p
+ * outbox.
+ */
+void channel_mailbox_put(int outbox)
+{
+	channel_put(CHANNEL_MAILBOX, outbox);
+}
+
+/*============================================================================*
+ * channel_portal_get()                                                       *
+ *============================================================================*/
+
+/**
+ * The channel_portal_get() function gets an output portal to the port
+ * @p port of the remote node @p remote.
+ */
+int channel_portal_get(int remote, int port)
+{
+	return (channel_get(CHANNEL_PORTAL, remote, port));
+}
+
+/*============================================================================*
+ * channel_portal_put()                                                       *
+ *============================================================================*/
+
+/**
+ * The channel_portal_put() function releases the output portal @p
+ * outportal.
+ */
+void channel_portal_put(int outportal)
+{
+	channel_put(CHANNEL_PORTAL, outportal);
+}
+
+/*============================================================================*
+ * channels_setup()                                                           *
+ *============================================================================*/
+
+/**
+ * The channels_setup() function initializes the table of reply
+ * channels. Only the first call takes effect.
+ */
+void channels_setup(void)
+{
+	/* Table is shared with other servers. */
+	if (channels.nusers++ > 0)
+		return;
+
+	spinlock_init(&channels.lock);
+	channels.clock = 0;
+
+	for (int i = 0; i < NANVIX_CHANNEL_MAILBOX_MAX; i++)
+	{
+		channels.mailboxes[i].fd = -1;
+		channels.mailboxes[i].busy = 0;
+	}
+
+	for (int i = 0; i < NANVIX_CHANNEL_PORTAL_MAX; i++)
+	{
+		channels.portals[i].fd = -1;
+		channels.portals[i].busy = 0;
+	}
+}
+
+/*============================================================================*
+ * channels_cleanup()                                                         *
+ *============================================================================*/
+
+/**
+ * The channels_cleanup() function closes all reply channels. Only the
+ * last call takes effect.
+ */
+void channels_cleanup(void)
+{
+	spinlock_lock(&channels.lock);
+
+		/* Table is still in use by other servers. */
+		if (--channels.nusers > 0)
+		{
+			spinlock_unlock(&channels.lock);
+			return;
+		}
+
+	spinlock_unlock(&channels.lock);
+
+	for (int i = 0; i < NANVIX_CHANNEL_MAILBOX_MAX; i++)
+	{
+		if (channels.mailboxes[i].fd >= 0)
+			channel_close(CHANNEL_MAILBOX, channels.mailboxes[i].fd);
+		channels.mailboxes[i].fd = -1;
+	}
+
+	for (int i = 0; i < NANVIX_CHANNEL_PORTAL_MAX; i++)
+	{
+		if (channels.portals[i].fd >= 0)
+			channel_close(CHANNEL_PORTAL, channels.portals[i].fd);
+		channels.portals[i].fd = -1;
+	}
+}
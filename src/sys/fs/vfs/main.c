@@ -26,6 +26,7 @@
 #define __VFS_SERVER
 
 #include <nanvix/servers/connection.h>
+#include <nanvix/servers/channel.h>
 #include <nanvix/runtime/runtime.h>
 #include <nanvix/sys/semaphore.h>
 #include <nanvix/sys/mailbox.h>
@@ -277,7 +278,7 @@ static int do_vfs_server_read(
 	/* XXX: forward parameter checking to lower level function. */
 
 	uassert((
-		outbox = kmailbox_open(
+		outbox = channel_mailbox_get(
 			request->header.source,
 			request->header.mailbox_port
 		)) >= 0
@@ -285,8 +286,7 @@ static int do_vfs_server_read(
 
 	/* Open portal to remote. */
 	uassert((outportal =
-		kportal_open(
-			knode_get_num(),
+		channel_portal_get(
 			request->header.source,
 			request->header.portal_port)
 		) >= 0
@@ -317,8 +317,8 @@ static int do_vfs_server_read(
 	);
 
 	/* House keeping. */
-	uassert(kportal_close(outportal) == 0);
-	uassert(kmailbox_close(outbox) == 0);
+	channel_portal_put(outportal);
+	channel_mailbox_put(outbox);
 
 	ret = vfs_read(
 		connection,
@@ -441,7 +441,7 @@ static int do_vfs_server_loop(void)
 		);
 
 		uassert((
-			outbox = kmailbox_open(
+			outbox = channel_mailbox_get(
 				request.header.source,
 				request.header.mailbox_port
 			)) >= 0
@@ -453,7 +453,7 @@ static int do_vfs_server_loop(void)
 				sizeof(struct vfs_message
 			)) == sizeof(struct vfs_message)
 		);
-		uassert(kmailbox_close(outbox) == 0);
+		channel_mailbox_put(outbox);
 	}
 
 #ifdef __SUPPRESS_TESTS
@@ -488,6 +488,7 @@ static int do_vfs_server_startup(struct nanvix_semaphore *lock)
 		return (ret);
 
 	connections_setup();
+	channels_setup();
 	vfs_init();
 
 	uprintf("[nanvix][vfs] minix file system created");
@@ -516,6 +517,7 @@ static int do_vfs_server_shutdown(void)
 {
 	uprintf("[nanvix][vfs] shutting down server");
 	vfs_shutdown();
+	channels_cleanup();
 
 	return (0);
 }
@@ -25,6 +25,7 @@
 #define __NEED_RMEM_SERVICE
 #define __NEED_RMEM_SERVER
 
+#include <nanvix/servers/channel.h>
 #include <nanvix/servers/message.h>
 #include <nanvix/runtime/pm.h>
 #include <nanvix/servers/rmem.h>
@@ -46,6 +47,24 @@
 #error "bad geometry for remote memory"
 #endif
 
+/**
+ * @brief Number of blocks that are served.
+ *
+ * The capacity is advertised to clients upon connection, thus it may
+ * be set to any multiple of the bitmap word length, up to @p
+ * RMEM_NUM_BLOCKS, without rebuilding clients.
+ */
+#ifndef __RMEM_CAPACITY
+#define __RMEM_CAPACITY RMEM_NUM_BLOCKS
+#endif
+
+/**
+ * @brief Bad capacity for remote memory?
+ */
+#if ((__RMEM_CAPACITY > RMEM_NUM_BLOCKS) || ((__RMEM_CAPACITY%BITMAP_WORD_LENGTH) != 0))
+#error "bad capacity for remote memory"
+#endif
+
 /**
  * @brief Debug RMEM?
  */
@@ -57,6 +76,94 @@
 	#define rmem_debug(fmt, ...) { }
 #endif
 
+/**
+ * @brief Number of worker threads.
+ *
+ * When zero, requests are handled by the thread that reads the input
+ * mailbox. Otherwise, this thread only dispatches requests to a pool
+ * of worker threads.
+ */
+#ifndef __RMEM_WORKERS_NUM
+#define __RMEM_WORKERS_NUM 0
+#endif
+
+/**
+ * @brief Length of the request queue of a worker thread.
+ *
+ * @note This should be a power of two.
+ */
+#define RMEM_QUEUE_LENGTH 8
+
+/**
+ * @brief Number of locks for remote memory blocks.
+ */
+#define RMEM_LOCKS_NUM 16
+
+/**
+ * @brief Gets the lock of a remote memory block.
+ *
+ * Blocks that share the same word of a bitmap share the same lock,
+ * thus bitmaps may be safely updated while holding a block lock.
+ */
+#define RMEM_LOCK(blknum) (IDX(blknum) % RMEM_LOCKS_NUM)
+
+/**
+ * @brief Length of the allocation map (in words).
+ */
+#define RMEM_BITMAP_LENGTH (RMEM_NUM_BLOCKS/BITMAP_WORD_LENGTH)
+
+/**
+ * @brief Length of the summary of the allocation map (in words).
+ */
+#define RMEM_SUMMARY_LENGTH \
+	((RMEM_BITMAP_LENGTH + BITMAP_WORD_LENGTH - 1)/BITMAP_WORD_LENGTH)
+
+/**
+ * @brief Number of physical pages that back remote memory.
+ */
+#define RMEM_NUM_PAGES (RMEM_SIZE/PAGE_SIZE)
+
+#ifdef __RMEM_USES_COMPRESSION
+
+	/**
+	 * @brief Size of the pool of compressed frames (in bytes).
+	 */
+	#define RMEM_ZPOOL_SIZE (RMEM_SIZE/4)
+
+	/**
+	 * @brief Allocation unit of the pool of compressed frames (in bytes).
+	 */
+	#define RMEM_ZCHUNK_SIZE 64
+
+	/**
+	 * @brief Number of allocation units in the pool of compressed frames.
+	 */
+	#define RMEM_NUM_ZCHUNKS (RMEM_ZPOOL_SIZE/RMEM_ZCHUNK_SIZE)
+
+	/**
+	 * @brief Maximum size of a compressed frame (in bytes).
+	 *
+	 * Frames that do not compress below this size stay uncompressed.
+	 */
+	#define RMEM_ZSIZE_MAX (RMEM_BLOCK_SIZE/2)
+
+	/**
+	 * @brief Marks the location of a frame as compressed.
+	 */
+	#define RMEM_ZFLAG (1U << 31)
+
+	/**
+	 * @brief Marks a record of a compressed frame as a run.
+	 */
+	#define RMEM_ZRUN (1U << 31)
+
+	/**
+	 * @brief Number of slots of physical memory for uncompressed frames.
+	 */
+	#define RMEM_NUM_SLOTS ((RMEM_SIZE - RMEM_ZPOOL_SIZE)/RMEM_BLOCK_SIZE)
+
+#endif
+
 /**
  * @brief Server statistics.
  */
@@ -75,6 +182,16 @@ static struct
 	unsigned nblocks;   /**< Blocks allocated       */
 } stats = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
+/**
+ * @brief Detailed server statistics.
+ */
+static struct rmem_stats counters;
+
+/**
+ * @brief Lock for server statistics.
+ */
+static spinlock_t stats_lock;
+
 /**
  * @brief Node number.
  */
@@ -102,14 +219,58 @@ static int serverid;
  */
 static struct
 {
-	char *blocks;                                        /**< Blocks         */
-	nanvix_pid_t owners[RMEM_NUM_BLOCKS];                /**< Owners         */
-	bitmap_t bitmap[RMEM_NUM_BLOCKS/BITMAP_WORD_LENGTH]; /**< Allocation Map */
+	char *blocks;                                        /**< Blocks            */
+	nanvix_pid_t owners[RMEM_NUM_BLOCKS];                /**< Owners            */
+	uint16_t refcounts[RMEM_NUM_BLOCKS];                 /**< Frame References  */
+	rpage_t frames[RMEM_NUM_BLOCKS];                     /**< Frames of Blocks  */
+	rpage_t forwards[RMEM_NUM_BLOCKS];                   /**< Forwarding Table  */
+	bitmap_t framemap[RMEM_BITMAP_LENGTH];               /**< Frame Map         */
+	bitmap_t bitmap[RMEM_BITMAP_LENGTH];                 /**< Allocation Map    */
+	bitmap_t summary[RMEM_SUMMARY_LENGTH];               /**< Full Words of Map */
+	bitmap_t dirty[RMEM_BITMAP_LENGTH];                  /**< Dirty Blocks      */
+	int restorable;                                      /**< Accepts Restores? */
+	unsigned cursor;                                     /**< Allocation Cursor */
+	bitmap_t backed[RMEM_NUM_PAGES/BITMAP_WORD_LENGTH];  /**< Backed Pages      */
+	bitmap_t backing[RMEM_NUM_PAGES/BITMAP_WORD_LENGTH]; /**< Pages in Backing  */
+	spinlock_t lock;                                     /**< Allocation Lock   */
+	struct nanvix_semaphore locks[RMEM_LOCKS_NUM];       /**< Locks for Blocks  */
+	struct nanvix_semaphore inportal_lock;               /**< Input Portal Lock */
+
+#ifdef __RMEM_USES_COMPRESSION
+	char *zpool;                                         /**< Compressed Pool   */
+	rpage_t locations[RMEM_NUM_BLOCKS];                  /**< Frame Locations   */
+	uint16_t zsizes[RMEM_NUM_BLOCKS];                    /**< Compressed Sizes  */
+	rpage_t slotframes[RMEM_NUM_SLOTS];                  /**< Frames in Slots   */
+	uint8_t pins[RMEM_NUM_SLOTS];                        /**< Pinned Slots      */
+	rpage_t pinned[RMEM_LOCKS_NUM];                      /**< Slots of Lockers  */
+	bitmap_t slotmap[RMEM_NUM_SLOTS/BITMAP_WORD_LENGTH]; /**< Slot Map          */
+	bitmap_t recent[RMEM_NUM_SLOTS/BITMAP_WORD_LENGTH];  /**< Recently Used     */
+	unsigned hand;                                       /**< Clock Hand        */
+	bitmap_t zmap[RMEM_NUM_ZCHUNKS/BITMAP_WORD_LENGTH];  /**< Pool Map          */
+	unsigned zcursor;                                    /**< Pool Cursor       */
+#endif
 } rmem;
 
 /**
- * @brief Map of blocks.
+ * @brief Contents of a block that was never written.
+ */
+static const char zeros[RMEM_BLOCK_SIZE];
+
+/**
+ * @brief Staging buffer for compression.
+ *
+ * @note The allocation lock should be held.
+ */
+#ifdef __RMEM_USES_COMPRESSION
+static char zbuf[RMEM_ZSIZE_MAX];
+#endif
+
+/**
+ * @brief Staging buffer for vectored operations.
  */
+#if (__RMEM_WORKERS_NUM == 0)
+static char staging[RMEM_IOV_MAX*RMEM_BLOCK_SIZE];
+#endif
 
 /*============================================================================*
  * rmem_server_get_name()                                                     *
@@ -150,356 +311,3458 @@ static int rmem_server_get_id(void)
 }
 
 /*============================================================================*
- * do_rmem_alloc()                                                            *
+ * rmem_memory_back()                                                         *
  *============================================================================*/
 
 /**
- * @brief Handles remote memory allocation.
+ * @brief Backs a range of remote memory with physical memory.
  *
- * @param owner Owner of the block.
+ * The allocation lock is released while physical memory is allocated,
+ * thus the caller should have reserved the target range beforehand.
+ * Pages that are being backed by other threads are waited for.
  *
- * @returns Upon successful completion, the number of the newly
- * allocated remote memory block is allocated. Upon failure, @p
- * RMEM_NULL is returned instead.
+ * @param ptr  Start of the target range.
+ * @param size Size of the target range (in bytes).
+ *
+ * @returns Non-zero if the allocation lock was released, and zero
+ * otherwise.
+ *
+ * @note The allocation lock should be held.
  */
-static inline rpage_t do_rmem_alloc(nanvix_pid_t owner)
+static int rmem_memory_back(char *ptr, size_t size)
 {
-	bitmap_t bit;
+	int released = 0;
+	rpage_t first = (ptr - rmem.blocks)/PAGE_SIZE;
+	rpage_t last = (ptr - rmem.blocks + size - 1)/PAGE_SIZE;
 
-	/* Memory server is full. */
-	if (stats.nblocks == RMEM_NUM_BLOCKS)
+	for (rpage_t pgnum = first; pgnum <= last; pgnum++)
 	{
-		uprintf("[nanvix][rmem] remote memory full");
-		return (RMEM_NULL);
-	}
+		/* Wait for other threads. */
+		while (bitmap_check_bit(rmem.backing, pgnum))
+		{
+			spinlock_unlock(&rmem.lock);
+			spinlock_lock(&rmem.lock);
+			released = 1;
+		}
 
-	/* Find a free block. */
-	uassert(
-		(bit = bitmap_first_free(
-			rmem.bitmap,
-			(RMEM_NUM_BLOCKS/BITMAP_WORD_LENGTH)*sizeof(bitmap_t)
-		)) != BITMAP_FULL
-	);
+		if (bitmap_check_bit(rmem.backed, pgnum))
+			continue;
 
-	/* Allocate block. */
-	stats.nblocks++;
-	bitmap_set(rmem.bitmap, bit);
-	rmem.owners[bit] = owner;
-	rmem_debug("rmem_alloc() blknum=%d nblocks=%d/%d",
-		bit, stats.nblocks, RMEM_NUM_BLOCKS
-	);
+		bitmap_set(rmem.backing, pgnum);
+		spinlock_unlock(&rmem.lock);
 
-	return (RMEM_BLOCK(serverid, bit));
+			uassert(page_alloc((vaddr_t) (rmem.blocks + pgnum*PAGE_SIZE)) == 0);
+
+		spinlock_lock(&rmem.lock);
+		bitmap_set(rmem.backed, pgnum);
+		bitmap_clear(rmem.backing, pgnum);
+		released = 1;
+	}
+
+	return (released);
 }
 
+#ifdef __RMEM_USES_COMPRESSION
+
 /*============================================================================*
- * do_rmem_free()                                                             *
+ * rmem_zcompress()                                                           *
  *============================================================================*/
 
 /**
- * @brief Handles remote memory free.
+ * @brief Compresses a frame.
  *
- * @param blknum Number of the target block.
- * @param owner Owner of the target block.
+ * Frames are encoded as a sequence of records, each of them made of a
+ * header word, that carries the number of words that it spans, and
+ * either a single word that is repeated (runs) or the words themselves
+ * (literals). Zero-filled frames and frames filled with short patterns
+ * thus compress down to a few bytes.
  *
- * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * @param dst Target buffer.
+ * @param src Target frame.
+ *
+ * @returns If the frame compresses down to @p RMEM_ZSIZE_MAX bytes,
+ * the size of the compressed frame is returned. Otherwise, zero is
+ * returned instead.
  */
-static inline int do_rmem_free(rpage_t blknum, nanvix_pid_t owner)
+static size_t rmem_zcompress(char *dst, const char *src)
 {
-	rpage_t _blknum;
+	size_t size = 0;
+	const uint32_t *words = (const uint32_t *) src;
+	const unsigned nwords = RMEM_BLOCK_SIZE/sizeof(uint32_t);
 
-	_blknum = RMEM_BLOCK_NUM(blknum);
+	for (unsigned i = 0; i < nwords; /* noop */)
+	{
+		uint32_t header;
+		unsigned n = 1;
 
-	/* Invalid block number. */
-	if ((_blknum == RMEM_NULL) || (_blknum >= RMEM_NUM_BLOCKS))
+		while (((i + n) < nwords) && (words[i + n] == words[i]))
+			n++;
+
+		/* Run. */
+		if (n > 1)
+		{
+			if ((size + 2*sizeof(uint32_t)) > RMEM_ZSIZE_MAX)
+				return (0);
+
+			header = RMEM_ZRUN | n;
+			umemcpy(&dst[size], &header, sizeof(uint32_t));
+			umemcpy(&dst[size + sizeof(uint32_t)], &words[i], sizeof(uint32_t));
+			size += 2*sizeof(uint32_t);
+			i += n;
+			continue;
+		}
+
+		/* Literals, up to the next run. */
+		while (((i + n) < nwords) &&
+			!(((i + n + 1) < nwords) && (words[i + n] == words[i + n + 1])))
+			n++;
+
+		if ((size + (n + 1)*sizeof(uint32_t)) > RMEM_ZSIZE_MAX)
+			return (0);
+
+		header = n;
+		umemcpy(&dst[size], &header, sizeof(uint32_t));
+		umemcpy(&dst[size + sizeof(uint32_t)], &words[i], n*sizeof(uint32_t));
+		size += (n + 1)*sizeof(uint32_t);
+		i += n;
+	}
+
+	return (size);
+}
+
+/*============================================================================*
+ * rmem_zdecompress()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Decompresses a frame.
+ *
+ * @param dst  Target frame.
+ * @param src  Compressed frame.
+ * @param size Size of the compressed frame (in bytes).
+ */
+static void rmem_zdecompress(char *dst, const char *src, size_t size)
+{
+	unsigned i = 0;
+	uint32_t *words = (uint32_t *) dst;
+
+	for (size_t off = 0; off < size; /* noop */)
 	{
-		uprintf("[nanvix][rmem] invalid block number");
-		return (-EINVAL);
+		uint32_t n;
+		uint32_t header;
+
+		umemcpy(&header, &src[off], sizeof(uint32_t));
+		off += sizeof(uint32_t);
+		n = header & ~RMEM_ZRUN;
+
+		/* Run. */
+		if (header & RMEM_ZRUN)
+		{
+			uint32_t word;
+
+			umemcpy(&word, &src[off], sizeof(uint32_t));
+			off += sizeof(uint32_t);
+
+			for (uint32_t j = 0; j < n; j++)
+				words[i++] = word;
+		}
+
+		/* Literals. */
+		else
+		{
+			umemcpy(&words[i], &src[off], n*sizeof(uint32_t));
+			off += n*sizeof(uint32_t);
+			i += n;
+		}
 	}
 
-	/* Remote memory is empty. */
-	if (stats.nblocks == 1)
+	uassert(i == RMEM_BLOCK_SIZE/sizeof(uint32_t));
+}
+
+/*============================================================================*
+ * rmem_zalloc()                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Allocates space in the pool of compressed frames.
+ *
+ * The allocated space is not backed by physical memory.
+ *
+ * @param size Number of bytes to allocate.
+ *
+ * @returns Upon successful completion, the number of the first
+ * allocated chunk is returned. Upon failure, a negative error code is
+ * returned instead.
+ *
+ * @note The allocation lock should be held.
+ */
+static int rmem_zalloc(size_t size)
+{
+	unsigned run = 0;
+	unsigned n = (size + RMEM_ZCHUNK_SIZE - 1)/RMEM_ZCHUNK_SIZE;
+
+	for (unsigned i = 0; i < RMEM_NUM_ZCHUNKS; i++)
 	{
-		uprintf("[nanvix][rmem] remote memory is empty");
-		return (-EFAULT);
+		unsigned first;
+		unsigned chunk = (rmem.zcursor + i) % RMEM_NUM_ZCHUNKS;
+
+		/* Runs do not wrap around. */
+		if (chunk == 0)
+			run = 0;
+
+		/* Skip full words. */
+		if ((OFF(chunk) == 0) && (rmem.zmap[IDX(chunk)] == BITMAP_FULL))
+		{
+			run = 0;
+			i += BITMAP_WORD_LENGTH - 1;
+			continue;
+		}
+
+		if (bitmap_check_bit(rmem.zmap, chunk))
+		{
+			run = 0;
+			continue;
+		}
+
+		if (++run < n)
+			continue;
+
+		first = chunk - n + 1;
+		for (unsigned j = first; j <= chunk; j++)
+			bitmap_set(rmem.zmap, j);
+		rmem.zcursor = (chunk + 1) % RMEM_NUM_ZCHUNKS;
+
+		return (first);
 	}
 
-	/* Bad block number. */
-	if (!bitmap_check_bit(rmem.bitmap, _blknum))
+	return (-ENOMEM);
+}
+
+/*============================================================================*
+ * rmem_zfree()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Releases space in the pool of compressed frames.
+ *
+ * @param first Number of the first chunk.
+ * @param size  Number of bytes to release.
+ *
+ * @note The allocation lock should be held.
+ */
+static void rmem_zfree(unsigned first, size_t size)
+{
+	unsigned n = (size + RMEM_ZCHUNK_SIZE - 1)/RMEM_ZCHUNK_SIZE;
+
+	for (unsigned j = first; j < first + n; j++)
+		bitmap_clear(rmem.zmap, j);
+}
+
+/*============================================================================*
+ * rmem_slot_evict()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Evicts a frame from a slot of physical memory.
+ *
+ * Slots are swept in clock order. Slots that were recently used get a
+ * second chance, and pinned slots are skipped. The frame in the first
+ * slot that is selected, and that fits in the pool of compressed
+ * frames, is moved there.
+ *
+ * @returns Upon successful completion, the number of the slot that was
+ * freed is returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note The allocation lock should be held. It may be released while
+ * physical memory is backed.
+ */
+static int rmem_slot_evict(void)
+{
+	/* Recently used bits are cleared on the first sweep. */
+	for (unsigned i = 0; i < 2*RMEM_NUM_SLOTS; i++)
 	{
-		uprintf("[nanvix][rmem] bad free block");
-		return (-EFAULT);
+		int chunk;
+		size_t size;
+		rpage_t frame;
+		rpage_t slot = rmem.hand;
+
+		rmem.hand = (rmem.hand + 1) % RMEM_NUM_SLOTS;
+
+		/* First slot is reserved. */
+		if ((slot == 0) || (rmem.pins[slot] > 0))
+			continue;
+
+		/* Second chance. */
+		if (bitmap_check_bit(rmem.recent, slot))
+		{
+			bitmap_clear(rmem.recent, slot);
+			continue;
+		}
+
+		frame = rmem.slotframes[slot];
+
+		/* Incompressible frame. */
+		if ((size = rmem_zcompress(zbuf, &rmem.blocks[slot*RMEM_BLOCK_SIZE])) == 0)
+			continue;
+
+		/* No room for this frame. */
+		if ((chunk = rmem_zalloc(size)) < 0)
+			continue;
+
+		/* Keep the frame in place while the pool is backed. */
+		rmem.pins[slot]++;
+		if (rmem_memory_back(&rmem.zpool[chunk*RMEM_ZCHUNK_SIZE], size))
+		{
+			rmem.pins[slot]--;
+
+			/* Frame was used or released meanwhile. */
+			if ((rmem.pins[slot] > 0) ||
+				(!bitmap_check_bit(rmem.slotmap, slot)) ||
+				(rmem.slotframes[slot] != frame) ||
+				(rmem_zcompress(zbuf, &rmem.blocks[slot*RMEM_BLOCK_SIZE]) != size))
+			{
+				rmem_zfree(chunk, size);
+				continue;
+			}
+		}
+		else
+			rmem.pins[slot]--;
+
+		umemcpy(&rmem.zpool[chunk*RMEM_ZCHUNK_SIZE], zbuf, size);
+		rmem.locations[frame] = RMEM_ZFLAG | chunk;
+		rmem.zsizes[frame] = size;
+		bitmap_clear(rmem.slotmap, slot);
+
+		rmem_debug("rmem_evict() frame=%d slot=%d size=%d",
+			frame, slot, size
+		);
+
+		return (slot);
 	}
 
-	/* Memory violation. */
-	if (rmem.owners[_blknum] != owner)
+	return (-ENOMEM);
+}
+
+/*============================================================================*
+ * rmem_slot_alloc()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Allocates a slot of physical memory.
+ *
+ * The location of the frame is not updated, so that it can be
+ * published once the slot is filled.
+ *
+ * @param frame Frame that is going to be stored in the slot.
+ *
+ * @returns Upon successful completion, the number of the allocated
+ * slot is returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note The allocation lock should be held. It may be released while
+ * physical memory is backed.
+ */
+static int rmem_slot_alloc(rpage_t frame)
+{
+	int slot = frame;
+
+	if ((frame >= RMEM_NUM_SLOTS) || bitmap_check_bit(rmem.slotmap, frame))
 	{
-		uprintf("[nanvix][rmem] memory violation");
-		return (-EFAULT);
+		bitmap_t bit;
+
+		/* Make room. */
+		if ((bit = bitmap_first_free(rmem.slotmap, sizeof(rmem.slotmap))) == BITMAP_FULL)
+		{
+			if ((slot = rmem_slot_evict()) < 0)
+				return (slot);
+		}
+		else
+			slot = bit;
 	}
 
-	/* Clean block. */
-	umemset(&rmem.blocks[_blknum*RMEM_BLOCK_SIZE], 0, RMEM_BLOCK_SIZE);
+	/* Keep other threads off the slot while it is backed. */
+	bitmap_set(rmem.slotmap, slot);
+	rmem.pins[slot]++;
+		rmem_memory_back(&rmem.blocks[slot*RMEM_BLOCK_SIZE], RMEM_BLOCK_SIZE);
+	rmem.pins[slot]--;
 
-	/* Free block. */
-	stats.nblocks--;
-	bitmap_clear(rmem.bitmap, _blknum);
-	rmem_debug("rmem_free() blknum=%d nblocks=%d/%d",
-		_blknum, stats.nblocks, RMEM_NUM_BLOCKS
-	);
+	bitmap_set(rmem.recent, slot);
+	rmem.slotframes[slot] = frame;
 
-	return (0);
+	return (slot);
+}
+
+#endif
+
+/*============================================================================*
+ * rmem_frame_alloc()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Allocates a frame.
+ *
+ * Frames hold the contents of blocks. They are numbered as blocks, and
+ * a block is stored in the frame with the same number whenever
+ * possible. Physical memory is allocated on the first use of a frame.
+ *
+ * @param hint Preferred frame.
+ *
+ * @returns Upon successful completion, the number of the allocated
+ * frame is returned. Upon failure, @p RMEM_NULL is returned instead.
+ *
+ * @note The allocation lock should be held. It may be released while
+ * physical memory is backed.
+ */
+static rpage_t rmem_frame_alloc(rpage_t hint)
+{
+	rpage_t frame = hint;
+
+	/*
+	 * There are never more frames in use than blocks
+	 * allocated, thus there is always a free frame.
+	 */
+	if (bitmap_check_bit(rmem.framemap, frame))
+	{
+		frame = bitmap_first_free(rmem.framemap, sizeof(rmem.framemap));
+		uassert(frame != BITMAP_FULL);
+	}
+
+	/* Reserve frame before backing it. */
+	bitmap_set(rmem.framemap, frame);
+	rmem.refcounts[frame] = 1;
+
+#ifdef __RMEM_USES_COMPRESSION
+	{
+		int slot;
+
+		if ((slot = rmem_slot_alloc(frame)) < 0)
+		{
+			bitmap_clear(rmem.framemap, frame);
+			rmem.refcounts[frame] = 0;
+			return (RMEM_NULL);
+		}
+
+		rmem.locations[frame] = slot;
+	}
+#else
+	rmem_memory_back(&rmem.blocks[frame*RMEM_BLOCK_SIZE], RMEM_BLOCK_SIZE);
+#endif
+
+	return (frame);
+}
+
+/*============================================================================*
+ * rmem_frame_put()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Releases a reference to a frame.
+ *
+ * @param frame Number of the target frame.
+ *
+ * @note The allocation lock should be held.
+ */
+static void rmem_frame_put(rpage_t frame)
+{
+	/* Block was never written. */
+	if (frame == RMEM_NULL)
+		return;
+
+	if (--rmem.refcounts[frame] > 0)
+		return;
+
+	bitmap_clear(rmem.framemap, frame);
+
+#ifdef __RMEM_USES_COMPRESSION
+	if (rmem.locations[frame] & RMEM_ZFLAG)
+		rmem_zfree(rmem.locations[frame] & ~RMEM_ZFLAG, rmem.zsizes[frame]);
+	else
+		bitmap_clear(rmem.slotmap, rmem.locations[frame]);
+#endif
+}
+
+/*============================================================================*
+ * rmem_frame_load()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Gets the contents of a frame.
+ *
+ * Compressed frames are decompressed into a slot of physical memory.
+ *
+ * @param frame Number of the target frame.
+ *
+ * @returns Upon successful completion, the contents of the target
+ * frame are returned. Upon failure, @p NULL is returned instead.
+ *
+ * @note The allocation lock should be held. It may be released while
+ * physical memory is backed.
+ */
+static char *rmem_frame_load(rpage_t frame)
+{
+#ifdef __RMEM_USES_COMPRESSION
+	rpage_t location = rmem.locations[frame];
+
+	/* Decompress frame. */
+	if (location & RMEM_ZFLAG)
+	{
+		int slot;
+
+		/* Out of memory. */
+		if ((slot = rmem_slot_alloc(frame)) < 0)
+			return (NULL);
+
+		/* Frame was decompressed meanwhile. */
+		if (!((location = rmem.locations[frame]) & RMEM_ZFLAG))
+			bitmap_clear(rmem.slotmap, slot);
+		else
+		{
+			unsigned chunk = location & ~RMEM_ZFLAG;
+
+			rmem_zdecompress(
+				&rmem.blocks[slot*RMEM_BLOCK_SIZE],
+				&rmem.zpool[chunk*RMEM_ZCHUNK_SIZE],
+				rmem.zsizes[frame]
+			);
+			rmem_zfree(chunk, rmem.zsizes[frame]);
+			rmem.locations[frame] = slot;
+		}
+	}
+
+	bitmap_set(rmem.recent, rmem.locations[frame]);
+
+	return (&rmem.blocks[rmem.locations[frame]*RMEM_BLOCK_SIZE]);
+#else
+	return (&rmem.blocks[frame*RMEM_BLOCK_SIZE]);
+#endif
+}
+
+/*============================================================================*
+ * rmem_frame_pin()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Gets the contents of a frame and pins it in physical memory.
+ *
+ * The frame stays pinned until the lock of the target block is
+ * released.
+ *
+ * @param blknum Number of the target block.
+ * @param frame  Number of the target frame.
+ *
+ * @returns Upon successful completion, the contents of the target
+ * frame are returned. Upon failure, @p NULL is returned instead.
+ *
+ * @note The allocation lock and the block lock should be held.
+ */
+static char *rmem_frame_pin(rpage_t blknum, rpage_t frame)
+{
+	char *data;
+
+	if ((data = rmem_frame_load(frame)) == NULL)
+		return (NULL);
+
+#ifdef __RMEM_USES_COMPRESSION
+	uassert(rmem.pinned[RMEM_LOCK(blknum)] == RMEM_NULL);
+	rmem.pinned[RMEM_LOCK(blknum)] = rmem.locations[frame];
+	rmem.pins[rmem.locations[frame]]++;
+#else
+	((void) blknum);
+#endif
+
+	return (data);
+}
+
+/*============================================================================*
+ * rmem_frame_unpin()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Unpins the frame that was pinned by the holder of a block lock.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @note The allocation lock and the block lock should be held.
+ */
+static inline void rmem_frame_unpin(rpage_t blknum)
+{
+#ifdef __RMEM_USES_COMPRESSION
+	rpage_t slot;
+
+	if ((slot = rmem.pinned[RMEM_LOCK(blknum)]) != RMEM_NULL)
+	{
+		rmem.pins[slot]--;
+		rmem.pinned[RMEM_LOCK(blknum)] = RMEM_NULL;
+	}
+#else
+	((void) blknum);
+#endif
+}
+
+/*============================================================================*
+ * rmem_block_lock()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Locks a remote memory block.
+ *
+ * @param blknum Number of the target block.
+ */
+static inline void rmem_block_lock(rpage_t blknum)
+{
+	nanvix_semaphore_down(&rmem.locks[RMEM_LOCK(blknum)]);
+}
+
+/*============================================================================*
+ * rmem_block_unlock()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Unlocks a remote memory block.
+ *
+ * @param blknum Number of the target block.
+ */
+static inline void rmem_block_unlock(rpage_t blknum)
+{
+#ifdef __RMEM_USES_COMPRESSION
+	spinlock_lock(&rmem.lock);
+		rmem_frame_unpin(blknum);
+	spinlock_unlock(&rmem.lock);
+#endif
+
+	nanvix_semaphore_up(&rmem.locks[RMEM_LOCK(blknum)]);
+}
+
+/*============================================================================*
+ * rmem_block_readable()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Gets the contents of a remote memory block for reading.
+ *
+ * Blocks that were never written since they were allocated read as
+ * zeros, and they may not even be backed by physical memory.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns Upon successful completion, the contents of the target
+ * block are returned. Upon failure, @p NULL is returned instead.
+ *
+ * @note The block lock should be held.
+ */
+static inline const char *rmem_block_readable(rpage_t blknum)
+{
+	const char *data;
+
+	if (rmem.frames[blknum] == RMEM_NULL)
+		return (zeros);
+
+#ifdef __RMEM_USES_COMPRESSION
+	spinlock_lock(&rmem.lock);
+		data = rmem_frame_pin(blknum, rmem.frames[blknum]);
+	spinlock_unlock(&rmem.lock);
+#else
+	data = rmem_frame_load(rmem.frames[blknum]);
+#endif
+
+	return (data);
+}
+
+/*============================================================================*
+ * rmem_block_writable()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Gets the contents of a remote memory block for writing.
+ *
+ * A frame is assigned to the target block on its first write, or on
+ * its first write after the block was cloned. Unless the whole block
+ * is going to be overwritten, the previous contents of the block are
+ * copied to the new frame.
+ *
+ * @param blknum Number of the target block.
+ * @param whole  Is the whole block going to be overwritten?
+ *
+ * @returns Upon successful completion, the contents of the target
+ * block are returned. Upon failure, @p NULL is returned instead.
+ *
+ * @note The block lock should be held.
+ */
+static char *rmem_block_writable(rpage_t blknum, int whole)
+{
+	rpage_t old;
+	rpage_t frame;
+	char *data = NULL;
+
+	spinlock_lock(&rmem.lock);
+
+		bitmap_set(rmem.dirty, blknum);
+
+		old = rmem.frames[blknum];
+
+		/* Private frame. */
+		if ((old != RMEM_NULL) && (rmem.refcounts[old] == 1))
+			data = rmem_frame_pin(blknum, old);
+
+		/* Copy on write. */
+		else if ((frame = rmem_frame_alloc(blknum)) != RMEM_NULL)
+		{
+			const char *src = zeros;
+
+			data = rmem_frame_pin(blknum, frame);
+
+			/* Out of memory. */
+			if ((!whole) && (old != RMEM_NULL) && ((src = rmem_frame_load(old)) == NULL))
+			{
+				rmem_frame_unpin(blknum);
+				rmem_frame_put(frame);
+				data = NULL;
+			}
+			else
+			{
+				if (!whole)
+					umemcpy(data, src, RMEM_BLOCK_SIZE);
+
+				rmem_frame_put(old);
+				rmem.frames[blknum] = frame;
+			}
+		}
+
+	spinlock_unlock(&rmem.lock);
+
+	return (data);
+}
+
+/*============================================================================*
+ * rmem_stats_record()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Gets the per-owner counters of a client.
+ *
+ * @param remote Node number of the target client.
+ *
+ * @returns The index of the per-owner counters of the target client is
+ * returned. If there is no room to track the target client, a negative
+ * number is returned instead.
+ *
+ * @note The lock for server statistics should be held.
+ */
+static int rmem_stats_owner(int remote)
+{
+	for (int i = 0; i < RMEM_STATS_OWNERS; i++)
+	{
+		if (counters.owners[i].nodenum == remote)
+			return (i);
+
+		/* Start tracking. */
+		if (counters.owners[i].nodenum < 0)
+		{
+			counters.owners[i].nodenum = remote;
+			return (i);
+		}
+	}
+
+	return (-1);
+}
+
+/**
+ * @brief Records statistics of a request.
+ *
+ * @param msg Target request.
+ * @param t   Time spent handling the request.
+ */
+static void rmem_stats_record(const struct rmem_message *msg, uint64_t t)
+{
+	int owner;
+	unsigned bucket = 0;
+	uint64_t nbytes = 0;
+	int opcode = msg->header.opcode;
+
+	while ((bucket < (RMEM_STATS_BUCKETS - 1)) && ((t >> (bucket + 1)) != 0))
+		bucket++;
+
+	spinlock_lock(&stats_lock);
+
+		owner = rmem_stats_owner(msg->header.source);
+
+		switch (opcode)
+		{
+			case RMEM_READ:
+			case RMEM_READ_PARTIAL:
+			case RMEM_READV:
+				nbytes = (opcode == RMEM_READ) ? RMEM_BLOCK_SIZE :
+					(opcode == RMEM_READV) ? (uint64_t) msg->nblocks*RMEM_BLOCK_SIZE : msg->size;
+				stats.nreads++;
+				stats.tread += t;
+				counters.nbytes_out += nbytes;
+				if (owner >= 0)
+					counters.owners[owner].nreads++;
+				break;
+
+			case RMEM_WRITE:
+			case RMEM_WRITE_PARTIAL:
+			case RMEM_WRITEV:
+				nbytes = (opcode == RMEM_WRITE) ? RMEM_BLOCK_SIZE :
+					(opcode == RMEM_WRITEV) ? (uint64_t) msg->nblocks*RMEM_BLOCK_SIZE : msg->size;
+				stats.nwrites++;
+				stats.twrite += t;
+				counters.nbytes_in += nbytes;
+				if (owner >= 0)
+					counters.owners[owner].nwrites++;
+				break;
+
+			case RMEM_ALLOC:
+			case RMEM_ALLOC_N:
+			case RMEM_CLONE:
+				stats.nallocs++;
+				stats.talloc += t;
+				if (owner >= 0)
+					counters.owners[owner].nallocs++;
+				break;
+
+			case RMEM_MEMFREE:
+			case RMEM_FREE_N:
+			case RMEM_FREE_ALL:
+				stats.nfrees++;
+				stats.tfree += t;
+				if (owner >= 0)
+					counters.owners[owner].nfrees++;
+				break;
+
+			default:
+				break;
+		}
+
+		if (owner >= 0)
+			counters.owners[owner].nbytes += nbytes;
+
+		if (opcode < RMEM_STATS_OPCODES)
+		{
+			counters.latencies[opcode][bucket]++;
+			counters.times[opcode] += t;
+		}
+
+	spinlock_unlock(&stats_lock);
+}
+
+/**
+ * @brief Records the depth of a request queue.
+ *
+ * @param depth Number of requests ahead in the queue.
+ */
+static inline void rmem_stats_depth(unsigned depth)
+{
+	if (depth >= RMEM_STATS_DEPTHS)
+		depth = RMEM_STATS_DEPTHS - 1;
+
+	spinlock_lock(&stats_lock);
+		counters.depths[depth]++;
+	spinlock_unlock(&stats_lock);
+}
+
+/*============================================================================*
+ * rmem_stats_snapshot()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Takes a snapshot of server statistics.
+ *
+ * @param buffer Location to store the snapshot.
+ */
+static void rmem_stats_snapshot(char *buffer)
+{
+	uint64_t now;
+
+	kclock(&now);
+
+	spinlock_lock(&stats_lock);
+		counters.uptime = now - stats.tstart;
+		counters.nblocks = stats.nblocks;
+		umemcpy(buffer, &counters, sizeof(struct rmem_stats));
+	spinlock_unlock(&stats_lock);
+}
+
+/*============================================================================*
+ * rmem_bitmap_first_free()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a free block.
+ *
+ * The search starts at the word of the allocation map pointed to by
+ * the allocation cursor. The summary map, in which a bit is set when
+ * the corresponding word of the allocation map is full, is used to
+ * skip full words, so the search takes a bounded number of steps
+ * regardless of occupancy.
+ *
+ * @returns Upon successful completion, the number of a free block is
+ * returned. Otherwise, @p BITMAP_FULL is returned instead.
+ *
+ * @note The allocation lock should be held.
+ */
+static bitmap_t rmem_bitmap_first_free(void)
+{
+	unsigned first = IDX(rmem.cursor);
+
+	/* Last iteration wraps around to the words before the cursor. */
+	for (unsigned i = 0; i <= RMEM_SUMMARY_LENGTH; i++)
+	{
+		unsigned word;
+		bitmap_t free;
+		unsigned sword = (first + i) % RMEM_SUMMARY_LENGTH;
+
+		free = ~rmem.summary[sword];
+
+		/* Skip words before the cursor. */
+		if (i == 0)
+			free &= ~((1U << OFF(rmem.cursor)) - 1);
+
+		/* All words are full. */
+		if (free == 0)
+			continue;
+
+		word = (sword << BITMAP_WORD_SHIFT) + __builtin_ctz(free);
+
+		/* Beyond the allocation map. */
+		if (word >= RMEM_BITMAP_LENGTH)
+			continue;
+
+		return ((word << BITMAP_WORD_SHIFT) + __builtin_ctz(~rmem.bitmap[word]));
+	}
+
+	return (BITMAP_FULL);
+}
+
+/*============================================================================*
+ * rmem_bitmap_set()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Marks a block as allocated.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @note The allocation lock should be held.
+ */
+static void rmem_bitmap_set(rpage_t blknum)
+{
+	bitmap_set(rmem.bitmap, blknum);
+	bitmap_set(rmem.dirty, blknum);
+
+	/* Word is now full. */
+	if (rmem.bitmap[IDX(blknum)] == BITMAP_FULL)
+		bitmap_set(rmem.summary, IDX(blknum));
+
+	rmem.cursor = IDX(blknum);
+}
+
+/*============================================================================*
+ * rmem_bitmap_clear()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Marks a block as free.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @note The allocation lock should be held.
+ */
+static void rmem_bitmap_clear(rpage_t blknum)
+{
+	bitmap_clear(rmem.bitmap, blknum);
+	bitmap_clear(rmem.summary, IDX(blknum));
+	bitmap_set(rmem.dirty, blknum);
+}
+
+/*============================================================================*
+ * rmem_block_is_live()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Checks if a block holds data in this server.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns One if the target block is allocated and was not migrated
+ * to another server, and zero otherwise.
+ */
+static inline int rmem_block_is_live(rpage_t blknum)
+{
+	return (bitmap_check_bit(rmem.bitmap, blknum) && (rmem.forwards[blknum] == RMEM_NULL));
+}
+
+/*============================================================================*
+ * rmem_nfree()                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Gets the number of free blocks.
+ *
+ * @returns The number of free blocks is returned.
+ */
+static inline uint32_t rmem_nfree(void)
+{
+	return (__RMEM_CAPACITY - stats.nblocks);
+}
+
+/*============================================================================*
+ * do_rmem_alloc()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Handles remote memory allocation.
+ *
+ * @param owner Owner of the block.
+ *
+ * @returns Upon successful completion, the number of the newly
+ * allocated remote memory block is allocated. Upon failure, @p
+ * RMEM_NULL is returned instead.
+ */
+static inline rpage_t do_rmem_alloc(nanvix_pid_t owner)
+{
+	bitmap_t bit;
+
+	spinlock_lock(&rmem.lock);
+
+	/* Memory server is full. */
+	if (stats.nblocks == __RMEM_CAPACITY)
+	{
+		spinlock_unlock(&rmem.lock);
+		uprintf("[nanvix][rmem] remote memory full");
+		return (RMEM_NULL);
+	}
+
+	/* Find a free block. */
+	uassert((bit = rmem_bitmap_first_free()) != BITMAP_FULL);
+
+	/* Allocate block. */
+	stats.nblocks++;
+	rmem_bitmap_set(bit);
+	rmem.owners[bit] = owner;
+	rmem.restorable = 0;
+	rmem_debug("rmem_alloc() blknum=%d nblocks=%d/%d",
+		bit, stats.nblocks, __RMEM_CAPACITY
+	);
+
+	spinlock_unlock(&rmem.lock);
+
+	return (RMEM_BLOCK(serverid, bit));
+}
+
+/*============================================================================*
+ * rmem_block_release()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Releases a remote memory block.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @note The lock of the target block and the allocation lock should
+ * be held.
+ */
+static void rmem_block_release(rpage_t blknum)
+{
+	/* Contents are lazily zeroed. */
+	rmem_frame_put(rmem.frames[blknum]);
+	rmem.frames[blknum] = RMEM_NULL;
+	rmem.forwards[blknum] = RMEM_NULL;
+	stats.nblocks--;
+	rmem_bitmap_clear(blknum);
+}
+
+/*============================================================================*
+ * do_rmem_free()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Handles remote memory free.
+ *
+ * @param blknum Number of the target block.
+ * @param owner Owner of the target block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static inline int do_rmem_free(rpage_t blknum, nanvix_pid_t owner)
+{
+	int ret = 0;
+	rpage_t _blknum;
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+	spinlock_lock(&rmem.lock);
+
+	/* Remote memory is empty. */
+	if (stats.nblocks == 1)
+	{
+		uprintf("[nanvix][rmem] remote memory is empty");
+		ret = -EFAULT;
+		goto out;
+	}
+
+	/* Bad block number. */
+	if (!bitmap_check_bit(rmem.bitmap, _blknum))
+	{
+		uprintf("[nanvix][rmem] bad free block");
+		ret = -EFAULT;
+		goto out;
+	}
+
+	/* Memory violation. */
+	if (rmem.owners[_blknum] != owner)
+	{
+		uprintf("[nanvix][rmem] memory violation");
+		ret = -EFAULT;
+		goto out;
+	}
+
+	rmem_block_release(_blknum);
+	rmem_debug("rmem_free() blknum=%d nblocks=%d/%d",
+		_blknum, stats.nblocks, __RMEM_CAPACITY
+	);
+
+out:
+	spinlock_unlock(&rmem.lock);
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_alloc_n()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Searches for a run of free blocks.
+ *
+ * @param want Number of wanted blocks.
+ * @param len  Location to store the length of the run.
+ *
+ * @returns The first block of the first run of @p want free blocks
+ * is returned. If there is no such run, the first block of the
+ * longest run is returned instead.
+ *
+ * @note The allocation lock should be held.
+ */
+static rpage_t rmem_bitmap_find_run(unsigned want, unsigned *len)
+{
+	unsigned bestlen = 0;
+	rpage_t best = RMEM_NULL;
+
+	for (rpage_t b = 1; b < __RMEM_CAPACITY; /* noop */)
+	{
+		unsigned run = 0;
+
+		/* Skip full words. */
+		if ((OFF(b) == 0) && (rmem.bitmap[IDX(b)] == BITMAP_FULL))
+		{
+			b += BITMAP_WORD_LENGTH;
+			continue;
+		}
+
+		/* Skip allocated block. */
+		if (bitmap_check_bit(rmem.bitmap, b))
+		{
+			b++;
+			continue;
+		}
+
+		/* Measure run. */
+		while ((run < want) && ((b + run) < __RMEM_CAPACITY))
+		{
+			if (bitmap_check_bit(rmem.bitmap, b + run))
+				break;
+			run++;
+		}
+
+		if (run > bestlen)
+		{
+			best = b;
+			bestlen = run;
+
+			/* Found. */
+			if (run == want)
+				break;
+		}
+
+		b += run;
+	}
+
+	*len = bestlen;
+
+	return (best);
+}
+
+/**
+ * @brief Handles allocation of many remote memory blocks.
+ *
+ * Contiguous runs of blocks are preferred. Allocated blocks are
+ * returned in the reply as a list of extents.
+ *
+ * @param msg   Target request.
+ * @param owner Owner of the blocks.
+ *
+ * @returns Upon successful completion, the number of allocated blocks
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+static int do_rmem_alloc_n(struct rmem_message *msg, nanvix_pid_t owner)
+{
+	int nextents = 0;
+	unsigned nallocated = 0;
+	unsigned want = msg->nblocks;
+
+	/* Invalid number of blocks. */
+	if (msg->nblocks <= 0)
+		return (-EINVAL);
+
+	spinlock_lock(&rmem.lock);
+
+		while ((nallocated < want) && (nextents < RMEM_EXTENTS_MAX))
+		{
+			unsigned len;
+			rpage_t start;
+
+			/* Memory server is full. */
+			if ((start = rmem_bitmap_find_run(want - nallocated, &len)) == RMEM_NULL)
+				break;
+
+			/* Allocate blocks. */
+			for (unsigned i = 0; i < len; i++)
+			{
+				rmem_bitmap_set(start + i);
+				rmem.owners[start + i] = owner;
+			}
+			stats.nblocks += len;
+			rmem.restorable = 0;
+
+			RMEM_EXTENT_START(msg, nextents) = RMEM_BLOCK(serverid, start);
+			RMEM_EXTENT_COUNT(msg, nextents) = len;
+			nextents++;
+			nallocated += len;
+
+			rmem_debug("rmem_alloc_n() blknum=%d len=%d nblocks=%d/%d",
+				start, len, stats.nblocks, __RMEM_CAPACITY
+			);
+		}
+
+	spinlock_unlock(&rmem.lock);
+
+	msg->nblocks = nextents;
+
+	/* Memory server is full. */
+	if (nallocated == 0)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		return (-ENOMEM);
+	}
+
+	return (nallocated);
+}
+
+/*============================================================================*
+ * do_rmem_free_n()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Handles free of many remote memory blocks.
+ *
+ * @param msg   Target request, which carries a list of extents.
+ * @param owner Owner of the blocks.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, the first error that was found is returned instead.
+ */
+static int do_rmem_free_n(const struct rmem_message *msg, nanvix_pid_t owner)
+{
+	int ret = 0;
+
+	/* Invalid number of extents. */
+	if ((msg->nblocks <= 0) || (msg->nblocks > RMEM_EXTENTS_MAX))
+		return (-EINVAL);
+
+	/* Invalid extent. */
+	for (int i = 0; i < msg->nblocks; i++)
+	{
+		rpage_t _start = RMEM_BLOCK_NUM(RMEM_EXTENT_START(msg, i));
+		rpage_t count = RMEM_EXTENT_COUNT(msg, i);
+
+		if ((count == 0) || (count > __RMEM_CAPACITY) ||
+			(_start >= __RMEM_CAPACITY) || (count > (__RMEM_CAPACITY - _start)))
+		{
+			uprintf("[nanvix][rmem] invalid extent");
+			return (-EINVAL);
+		}
+	}
+
+	for (int i = 0; i < msg->nblocks; i++)
+	{
+		rpage_t start = RMEM_EXTENT_START(msg, i);
+
+		for (rpage_t j = 0; j < RMEM_EXTENT_COUNT(msg, i); j++)
+		{
+			int err;
+
+			if (((err = do_rmem_free(start + j, owner)) < 0) && (ret == 0))
+				ret = err;
+		}
+	}
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_free_all()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Handles free of all remote memory blocks of an owner.
+ *
+ * Blocks are released one word of the allocation map at a time,
+ * since all blocks in a word share the same lock.
+ *
+ * @param owner Owner of the blocks.
+ *
+ * @returns The number of blocks that were released is returned.
+ */
+static int do_rmem_free_all(nanvix_pid_t owner)
+{
+	int nfreed = 0;
+
+	rmem_debug("free_all() owner=%d", owner);
+
+	for (rpage_t i = 0; i < (__RMEM_CAPACITY/BITMAP_WORD_LENGTH); i++)
+	{
+		rpage_t first = i*BITMAP_WORD_LENGTH;
+
+		/* Skip empty words. */
+		if (rmem.bitmap[i] == 0)
+			continue;
+
+		rmem_block_lock(first);
+		spinlock_lock(&rmem.lock);
+
+			for (rpage_t j = 0; j < BITMAP_WORD_LENGTH; j++)
+			{
+				rpage_t blknum = first + j;
+
+				/* First block is never released. */
+				if (blknum == RMEM_NULL)
+					continue;
+
+				if (!bitmap_check_bit(rmem.bitmap, blknum))
+					continue;
+
+				if (rmem.owners[blknum] != owner)
+					continue;
+
+				rmem_block_release(blknum);
+				nfreed++;
+			}
+
+		spinlock_unlock(&rmem.lock);
+		rmem_block_unlock(first);
+	}
+
+	rmem_debug("free_all() nfreed=%d nblocks=%d/%d",
+		nfreed, stats.nblocks, __RMEM_CAPACITY
+	);
+
+	return (nfreed);
+}
+
+/*============================================================================*
+ * do_rmem_migrate()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Handles the migration of a block to another server.
+ *
+ * The client copies the contents of the block to its new location
+ * beforehand. The frame of the block is then released, but its
+ * number is kept reserved until it is freed, along with a forwarding
+ * entry to the new location. Further accesses to the block fail.
+ *
+ * @param blknum Number of the target block.
+ * @param target Number of the block in the new location.
+ * @param owner  Owner of the target block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_migrate(rpage_t blknum, rpage_t target, nanvix_pid_t owner)
+{
+	int ret = 0;
+	rpage_t _blknum;
+
+	rmem_debug("migrate() blknum=%x target=%x", blknum, target);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid target. */
+	if ((target == RMEM_NULL) || (RMEM_BLOCK_SERVER(target) == (rpage_t) serverid))
+		return (-EINVAL);
+
+	rmem_block_lock(_blknum);
+	spinlock_lock(&rmem.lock);
+
+		/* Bad block number. */
+		if (!rmem_block_is_live(_blknum))
+			ret = -EFAULT;
+
+		/* Memory violation. */
+		else if (rmem.owners[_blknum] != owner)
+		{
+			uprintf("[nanvix][rmem] memory violation");
+			ret = -EFAULT;
+		}
+
+		else
+		{
+			rmem_frame_put(rmem.frames[_blknum]);
+			rmem.frames[_blknum] = RMEM_NULL;
+			rmem.forwards[_blknum] = target;
+			bitmap_set(rmem.dirty, _blknum);
+		}
+
+	spinlock_unlock(&rmem.lock);
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_clone()                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Handles remote memory block cloning.
+ *
+ * The clone shares the frame of the source block until one of them
+ * is written.
+ *
+ * @param blknum Number of the source block.
+ * @param owner  Owner of the clone.
+ *
+ * @returns Upon successful completion, the number of the clone is
+ * returned. Upon failure, @p RMEM_NULL is returned instead.
+ */
+static inline rpage_t do_rmem_clone(rpage_t blknum, nanvix_pid_t owner)
+{
+	bitmap_t bit = RMEM_NULL;
+	rpage_t _blknum;
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (RMEM_NULL);
+	}
+
+	rmem_block_lock(_blknum);
+	spinlock_lock(&rmem.lock);
+
+	/* Bad block number. */
+	if (!rmem_block_is_live(_blknum))
+	{
+		uprintf("[nanvix][rmem] bad clone block");
+		goto out;
+	}
+
+	/* Memory server is full. */
+	if (stats.nblocks == __RMEM_CAPACITY)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		goto out;
+	}
+
+	/* Allocate block. */
+	uassert((bit = rmem_bitmap_first_free()) != BITMAP_FULL);
+	stats.nblocks++;
+	rmem_bitmap_set(bit);
+	rmem.owners[bit] = owner;
+	rmem.restorable = 0;
+
+	/* Share frame. */
+	if ((rmem.frames[bit] = rmem.frames[_blknum]) != RMEM_NULL)
+		rmem.refcounts[rmem.frames[bit]]++;
+
+	rmem_debug("rmem_clone() blknum=%d clone=%d nblocks=%d/%d",
+		_blknum, bit, stats.nblocks, __RMEM_CAPACITY
+	);
+
+out:
+	spinlock_unlock(&rmem.lock);
+	rmem_block_unlock(_blknum);
+
+	return ((bit == RMEM_NULL) ? RMEM_NULL : RMEM_BLOCK(serverid, bit));
+}
+
+/*============================================================================*
+ * rmem_range_is_valid()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether a byte range lies within a block.
+ *
+ * @param offset Offset within the block.
+ * @param size   Number of bytes.
+ *
+ * @returns One if the target range is valid, and zero otherwise.
+ */
+static inline int rmem_range_is_valid(size_t offset, size_t size)
+{
+	return ((size > 0) && (offset < RMEM_BLOCK_SIZE) && (size <= (RMEM_BLOCK_SIZE - offset)));
+}
+
+/*============================================================================*
+ * do_rmem_zero()                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Handles a write of a block that is all zeros.
+ *
+ * No data is transferred. Instead, the frame of the target block is
+ * released, thus the block reads as zeros again.
+ *
+ * @param blknum Number of the target block.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_zero(rpage_t blknum)
+{
+	int ret = 0;
+	rpage_t _blknum;
+
+	rmem_debug("zero() blknum=%x", blknum);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+		/* Bad block number. */
+		if (!rmem_block_is_live(_blknum))
+		{
+			uprintf("[nanvix][rmem] bad write block");
+			ret = -EFAULT;
+		}
+		else
+		{
+			spinlock_lock(&rmem.lock);
+				rmem_frame_put(rmem.frames[_blknum]);
+				rmem.frames[_blknum] = RMEM_NULL;
+				bitmap_set(rmem.dirty, _blknum);
+			spinlock_unlock(&rmem.lock);
+		}
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_atomic()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Handles an atomic operation on a word of a block.
+ *
+ * Atomicity comes from the block lock, which is also held by reads
+ * and writes of the target block.
+ *
+ * @param opcode   Atomic operation.
+ * @param blknum   Number of the target block.
+ * @param offset   Offset of the target word within the target block.
+ * @param value    Operand. The previous value of the target word is
+ *                 stored here.
+ * @param expected Expected value (compare-and-swap only).
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_atomic(int opcode, rpage_t blknum, size_t offset, uint64_t *value, uint64_t expected)
+{
+	int ret = 0;
+	char *block;
+	uint64_t old;
+	uint64_t *word;
+	rpage_t _blknum;
+
+	rmem_debug("atomic() opcode=%d blknum=%x offset=%d",
+		opcode,
+		blknum,
+		offset
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid word. */
+	if ((offset >= RMEM_BLOCK_SIZE) || ((offset % sizeof(uint64_t)) != 0))
+	{
+		uprintf("[nanvix][rmem] invalid atomic offset");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+		/* Bad block number. */
+		if (!rmem_block_is_live(_blknum))
+		{
+			uprintf("[nanvix][rmem] bad atomic block");
+			ret = -EFAULT;
+		}
+		else if ((block = rmem_block_writable(_blknum, 0)) == NULL)
+		{
+			uprintf("[nanvix][rmem] remote memory full");
+			ret = -ENOMEM;
+		}
+		else
+		{
+			word = (uint64_t *) &block[offset];
+			old = *word;
+
+			switch (opcode)
+			{
+				case RMEM_ATOMIC_ADD:
+					*word = old + *value;
+					break;
+
+				case RMEM_ATOMIC_CAS:
+					if (old == expected)
+						*word = *value;
+					break;
+
+				case RMEM_ATOMIC_SWAP:
+					*word = *value;
+					break;
+
+				case RMEM_ATOMIC_OR:
+					*word = old | *value;
+					break;
+
+				/* Should not happen. */
+				default:
+					ret = -EINVAL;
+					break;
+			}
+
+			*value = old;
+		}
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_write()                                                            *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Handles a write request.
+ *
+ * @param remote      Remote client.
+ * @param blknum      Number of the target block.
+ * @param offset      Offset within the target block.
+ * @param size        Number of bytes to write.
+ * @param remote_port Portal port of the remote client.
+ */
+static inline int do_rmem_write(int remote, rpage_t blknum, size_t offset, size_t size, int remote_port)
+{
+	int ret = 0;
+	char *block;
+	rpage_t _blknum;
+
+	rmem_debug("write() nodenum=%d blknum=%x offset=%d size=%d",
+		remote,
+		blknum,
+		offset,
+		size
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid range. */
+	if (!rmem_range_is_valid(offset, size))
+	{
+		uprintf("[nanvix][rmem] invalid write range");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+	/*
+	 * Bad block number. Drop this read and return
+	 * an error. Note that we use the NULL block for this.
+	 */
+	if (!rmem_block_is_live(_blknum))
+	{
+		uprintf("[nanvix][rmem] bad write block");
+		block = &rmem.blocks[0];
+		ret = -EFAULT;
+	}
+	else if ((block = rmem_block_writable(_blknum, (size == RMEM_BLOCK_SIZE))) == NULL)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		block = &rmem.blocks[0];
+		ret = -ENOMEM;
+	}
+
+	nanvix_semaphore_down(&rmem.inportal_lock);
+		uassert(kportal_allow(inportal, remote, remote_port) == 0);
+		uassert(
+			kportal_read(
+				inportal,
+				&block[offset],
+				size
+			) == (ssize_t) size
+		);
+	nanvix_semaphore_up(&rmem.inportal_lock);
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+#else
+
+/**
+ * @brief Handles a write request.
+ *
+ * @param blknum  Number of the target block.
+ * @param offset  Offset within the target block.
+ * @param size    Number of bytes to write.
+ * @param payload Data to write.
+ */
+static inline int do_rmem_write(rpage_t blknum, size_t offset, size_t size, const char *payload)
+{
+	int ret = 0;
+	char *block;
+	rpage_t _blknum;
+
+	rmem_debug("write() blknum=%x offset=%d size=%d",
+		blknum,
+		offset,
+		size
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid range. */
+	if (!rmem_range_is_valid(offset, size) || (size > RMEM_PAYLOAD_SIZE))
+	{
+		uprintf("[nanvix][rmem] invalid write range");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+	/*
+	 * Bad block number. Drop this read and return
+	 * an error. Note that we use the NULL block for this.
+	 */
+	if (!rmem_block_is_live(_blknum))
+	{
+		uprintf("[nanvix][rmem] bad write block");
+		block = &rmem.blocks[0];
+		ret = -EFAULT;
+	}
+	else if ((block = rmem_block_writable(_blknum, 0)) == NULL)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		block = &rmem.blocks[0];
+		ret = -ENOMEM;
+	}
+
+	umemcpy(&block[offset], payload, size);
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+#endif
+
+/*============================================================================*
+ * do_rmem_read()                                                             *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Handles a read request.
+ *
+ * @param remote  Remote client.
+ * @param blknum  Number of the target block.
+ * @param offset  Offset within the target block.
+ * @param size    Number of bytes to read.
+ * @param outbox  Output mailbox to remote client.
+ * @param tag     Tag of the request.
+ * @param outport Portal port of the remote client.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static inline int do_rmem_read(int remote, rpage_t blknum, size_t offset, size_t size, int outbox, uint32_t tag, int outport)
+{
+	int ret = 0;
+	int outportal;
+	rpage_t _blknum;
+	const char *block;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+
+	rmem_debug("read() nodenum=%d blknum=%x offset=%d size=%d",
+		remote,
+		blknum,
+		offset,
+		size
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid range. */
+	if (!rmem_range_is_valid(offset, size))
+	{
+		uprintf("[nanvix][rmem] invalid read range");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+	/*
+	 * Bad block number. Let us send a null block
+	 * and return an error instead.
+	 */
+	if (!rmem_block_is_live(_blknum))
+	{
+		uprintf("[nanvix][rmem] bad read block");
+		block = zeros;
+		ret = -EFAULT;
+	}
+	else if ((block = rmem_block_readable(_blknum)) == NULL)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		block = zeros;
+		ret = -ENOMEM;
+	}
+
+	/* No block is pushed. */
+	msg.nblocks = 0;
+	msg.flags = (block == zeros) ? RMEM_FLAG_ZERO : 0;
+
+	/* Zero block. Client fills it in locally. */
+	if (msg.flags & RMEM_FLAG_ZERO)
+	{
+		uassert(
+			kmailbox_write(outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == sizeof(struct rmem_message)
+		);
+	}
+	else
+	{
+		uassert((outportal = channel_portal_get(remote, outport)) >= 0);
+		msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+		uassert(
+			kmailbox_write(outbox,
+				&msg,
+				sizeof(struct rmem_message)
+			) == sizeof(struct rmem_message)
+		);
+		uassert(
+			kportal_write(
+				outportal,
+				&block[offset],
+				size
+			) == (ssize_t) size
+		);
+		channel_portal_put(outportal);
+	}
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+#else
+
+/**
+ * @brief Handles a read request.
+ *
+ * @param blknum Number of the target block.
+ * @param offset Offset within the target block.
+ * @param size   Number of bytes to read.
+ * @param outbox Output mailbox to remote client.
+ * @param tag    Tag of the request.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static inline int do_rmem_read(rpage_t blknum, size_t offset, size_t size, int outbox, uint32_t tag)
+{
+	int ret = 0;
+	rpage_t _blknum;
+	const char *block;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+	msg.blknum = blknum;
+
+	rmem_debug("read() blknum=%x offset=%d size=%d",
+		blknum,
+		offset,
+		size
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Invalid range. */
+	if (!rmem_range_is_valid(offset, size))
+	{
+		uprintf("[nanvix][rmem] invalid read range");
+		return (-EINVAL);
+	}
+
+	rmem_block_lock(_blknum);
+
+	/*
+	 * Bad block number. Let us send a null block
+	 * and return an error instead.
+	 */
+	if (!rmem_block_is_live(_blknum))
+	{
+		uprintf("[nanvix][rmem] bad read block");
+		block = zeros;
+		ret = -EFAULT;
+	}
+	else if ((block = rmem_block_readable(_blknum)) == NULL)
+	{
+		uprintf("[nanvix][rmem] remote memory full");
+		block = zeros;
+		ret = -ENOMEM;
+	}
+
+	msg.flags = (block == zeros) ? RMEM_FLAG_ZERO : 0;
+
+	for (size_t i = 0; i < size; i += RMEM_PAYLOAD_SIZE)
+	{
+		msg.offset = offset + i;
+		msg.size = ((size - i) < RMEM_PAYLOAD_SIZE) ?
+			(size - i) : RMEM_PAYLOAD_SIZE;
+
+		/* Zero block. Client fills it in locally. */
+		if (msg.flags & RMEM_FLAG_ZERO)
+		{
+			msg.size = size;
+			uassert(
+				kmailbox_write(
+					outbox,
+					&msg, sizeof(struct rmem_message)
+				) == sizeof(struct rmem_message)
+			);
+			break;
+		}
+
+		umemcpy(&msg.payload, &block[msg.offset], msg.size);
+
+		uassert(
+			kmailbox_write(
+				outbox,
+				&msg, sizeof(struct rmem_message)
+			) == sizeof(struct rmem_message)
+		);
+	}
+
+	rmem_block_unlock(_blknum);
+
+	return (ret);
+}
+
+#endif
+
+/*============================================================================*
+ * do_rmem_readv()                                                            *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Checks if a list of blocks is valid.
+ *
+ * @param blknums Numbers of the target blocks.
+ * @param nblocks Number of blocks.
+ *
+ * @returns Non-zero if the list is valid and zero otherwise.
+ */
+static int rmem_iov_is_valid(const rpage_t *blknums, int nblocks)
+{
+	/* Invalid number of blocks. */
+	if ((nblocks <= 0) || (nblocks > RMEM_IOV_MAX))
+		return (0);
+
+	for (int i = 0; i < nblocks; i++)
+	{
+		rpage_t _blknum = RMEM_BLOCK_NUM(blknums[i]);
+
+		/* Invalid block number. */
+		if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+			return (0);
+	}
+
+	return (1);
+}
+
+/**
+ * @brief Handles a vectored read request.
+ *
+ * Blocks are gathered in a staging buffer, which is then sent to the
+ * remote client in a single portal transfer.
+ *
+ * @param remote  Remote client.
+ * @param blknums Numbers of the target blocks.
+ * @param nblocks Number of blocks.
+ * @param outbox  Output mailbox to remote client.
+ * @param tag     Tag of the request.
+ * @param outport Port of the input portal of the remote client.
+ * @param buffer  Staging buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_readv(
+	int remote,
+	const rpage_t *blknums,
+	int nblocks,
+	int outbox,
+	uint32_t tag,
+	int outport,
+	char *buffer
+)
+{
+	int ret = 0;
+	int outportal;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+
+	rmem_debug("readv() nodenum=%d nblocks=%d",
+		remote,
+		nblocks
+	);
+
+	/* Invalid list of blocks. */
+	if (!rmem_iov_is_valid(blknums, nblocks))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	/* Gather blocks. */
+	for (int i = 0; i < nblocks; i++)
+	{
+		const char *block;
+		rpage_t _blknum = RMEM_BLOCK_NUM(blknums[i]);
+
+		rmem_block_lock(_blknum);
+
+			/*
+			 * Bad block number. Let us send a null block
+			 * and return an error instead.
+			 */
+			if (!rmem_block_is_live(_blknum))
+			{
+				uprintf("[nanvix][rmem] bad read block");
+				ret = -EFAULT;
+				block = zeros;
+			}
+			else if ((block = rmem_block_readable(_blknum)) == NULL)
+			{
+				uprintf("[nanvix][rmem] remote memory full");
+				ret = -ENOMEM;
+				block = zeros;
+			}
+
+			umemcpy(&buffer[i*RMEM_BLOCK_SIZE], block, RMEM_BLOCK_SIZE);
+
+		rmem_block_unlock(_blknum);
+	}
+
+	uassert((outportal = channel_portal_get(remote, outport)) >= 0);
+	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+	uassert(
+		kmailbox_write(outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == sizeof(struct rmem_message)
+	);
+	uassert(
+		kportal_write(
+			outportal,
+			buffer,
+			nblocks*RMEM_BLOCK_SIZE
+		) == (ssize_t) (nblocks*RMEM_BLOCK_SIZE)
+	);
+	channel_portal_put(outportal);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * Access Streams                                                             *
+ *============================================================================*/
+
+/**
+ * @brief Maximum number of access streams.
+ */
+#define RMEM_STREAMS_NUM NANVIX_PROC_MAX
+
+/**
+ * @brief Access streams of clients.
+ *
+ * A stream is only touched by the thread that handles requests of its
+ * client, thus it is locked only when it is claimed.
+ */
+static struct rmem_stream
+{
+	int nodenum;      /**< Client (negative if unused). */
+	int depth;        /**< Prefetch depth.              */
+	int delta;        /**< Last distance between reads. */
+	int stride;       /**< Detected stride.             */
+	rpage_t last;     /**< Last block read.             */
+	rpage_t frontier; /**< Last block pushed.           */
+} streams[RMEM_STREAMS_NUM];
+
+/**
+ * @brief Gets the access stream of a client.
+ *
+ * @param remote Node number of the target client.
+ *
+ * @returns The access stream of the target client is returned. If
+ * there is no room to track the target client, NULL is returned
+ * instead.
+ */
+static struct rmem_stream *rmem_stream_get(int remote)
+{
+	struct rmem_stream *stream = NULL;
+
+	spinlock_lock(&rmem.lock);
+
+		for (int i = 0; i < RMEM_STREAMS_NUM; i++)
+		{
+			if (streams[i].nodenum == remote)
+			{
+				stream = &streams[i];
+				break;
+			}
+
+			/* Start tracking. */
+			if (streams[i].nodenum < 0)
+			{
+				umemset(&streams[i], 0, sizeof(struct rmem_stream));
+				streams[i].nodenum = remote;
+				stream = &streams[i];
+				break;
+			}
+		}
+
+	spinlock_unlock(&rmem.lock);
+
+	return (stream);
+}
+
+/**
+ * @brief Predicts which blocks a client is going to read next.
+ *
+ * A stride is detected when two consecutive reads are equally
+ * distant. Once detected, it is kept as long as the client reads the
+ * block that comes right after those that were pushed to it. Blocks
+ * are never pushed twice in a stream.
+ *
+ * @param remote  Node number of the target client.
+ * @param blknum  Number of the block that is being read.
+ * @param blknums Location to store the numbers of predicted blocks.
+ *
+ * @returns The number of predicted blocks is returned.
+ */
+static int rmem_stream_predict(int remote, rpage_t blknum, rpage_t *blknums)
+{
+	int n = 0;
+	int delta;
+	rpage_t _blknum;
+	struct rmem_stream *stream;
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	/* Invalid block number. */
+	if ((_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+		return (0);
+
+	/* Prefetch disabled. */
+	if (((stream = rmem_stream_get(remote)) == NULL) || (stream->depth == 0))
+		return (0);
+
+	delta = (int) _blknum - (int) stream->last;
+
+	/* Client is still in the stream. */
+	if ((stream->stride != 0) && ((int) _blknum == ((int) stream->frontier + stream->stride)))
+		/* noop */ ;
+
+	/* New stride. */
+	else if ((delta != 0) && (delta == stream->delta))
+	{
+		if (stream->stride != delta)
+		{
+			stream->stride = delta;
+			stream->frontier = _blknum;
+		}
+	}
+
+	/* No stride. */
+	else
+		stream->stride = 0;
+
+	stream->delta = delta;
+	stream->last = _blknum;
+
+	if (stream->stride == 0)
+		return (0);
+
+	for (int i = 1; i <= stream->depth; i++)
+	{
+		int next = (int) _blknum + i*stream->stride;
+
+		/* Out of range. */
+		if ((next <= 0) || (next >= __RMEM_CAPACITY))
+			break;
+
+		/* Already pushed. */
+		if (((next - (int) stream->frontier)*stream->stride) <= 0)
+			continue;
+
+		blknums[n++] = next;
+	}
+
+	if (n > 0)
+		stream->frontier = blknums[n - 1];
+
+	return (n);
+}
+
+/*============================================================================*
+ * do_rmem_read_ahead()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Handles a read request and pushes blocks ahead of it.
+ *
+ * The target block and the pushed blocks are gathered in a staging
+ * buffer, and sent in a single portal transfer. The acknowledge
+ * carries the numbers of the blocks that were pushed. Blocks that
+ * cannot be read are silently dropped from the push.
+ *
+ * @param remote  Remote client.
+ * @param blknum  Number of the target block.
+ * @param blknums Numbers of the blocks to push.
+ * @param n       Number of blocks to push.
+ * @param outbox  Output mailbox to remote client.
+ * @param tag     Tag of the request.
+ * @param outport Portal port of the remote client.
+ * @param buffer  Staging buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_read_ahead(
+	int remote,
+	rpage_t blknum,
+	const rpage_t *blknums,
+	int n,
+	int outbox,
+	uint32_t tag,
+	int outport,
+	char *buffer
+)
+{
+	int ret = 0;
+	int outportal;
+	int npushed = 0;
+	rpage_t _blknum;
+	const char *block;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+
+	rmem_debug("read_ahead() nodenum=%d blknum=%x n=%d",
+		remote,
+		blknum,
+		n
+	);
+
+	_blknum = RMEM_BLOCK_NUM(blknum);
+
+	rmem_block_lock(_blknum);
+
+		/*
+		 * Bad block number. Let us send a null block
+		 * and return an error instead.
+		 */
+		if (!rmem_block_is_live(_blknum))
+		{
+			uprintf("[nanvix][rmem] bad read block");
+			block = zeros;
+			ret = -EFAULT;
+		}
+		else if ((block = rmem_block_readable(_blknum)) == NULL)
+		{
+			uprintf("[nanvix][rmem] remote memory full");
+			block = zeros;
+			ret = -ENOMEM;
+		}
+
+		umemcpy(buffer, block, RMEM_BLOCK_SIZE);
+
+	rmem_block_unlock(_blknum);
+
+	/* Gather blocks to push. */
+	for (int i = 0; i < n; i++)
+	{
+		rmem_block_lock(blknums[i]);
+
+			if (rmem_block_is_live(blknums[i]) &&
+				((block = rmem_block_readable(blknums[i])) != NULL))
+			{
+				umemcpy(&buffer[(npushed + 1)*RMEM_BLOCK_SIZE], block, RMEM_BLOCK_SIZE);
+				msg.blknums[npushed++] = RMEM_BLOCK(serverid, blknums[i]);
+			}
+
+		rmem_block_unlock(blknums[i]);
+	}
+
+	msg.nblocks = npushed;
+	msg.flags = 0;
+
+	uassert((outportal = channel_portal_get(remote, outport)) >= 0);
+	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+	uassert(
+		kmailbox_write(outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == sizeof(struct rmem_message)
+	);
+	uassert(
+		kportal_write(
+			outportal,
+			buffer,
+			(npushed + 1)*RMEM_BLOCK_SIZE
+		) == (ssize_t) ((npushed + 1)*RMEM_BLOCK_SIZE)
+	);
+	channel_portal_put(outportal);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_writev()                                                           *
+ *============================================================================*/
+
+/**
+ * @brief Handles a vectored write request.
+ *
+ * Blocks are received in a staging buffer, in a single portal
+ * transfer, and then scattered. Bad blocks are dropped.
+ *
+ * @param remote      Remote client.
+ * @param blknums     Numbers of the target blocks.
+ * @param nblocks     Number of blocks.
+ * @param remote_port Port of the output portal of the remote client.
+ * @param buffer      Staging buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_writev(
+	int remote,
+	const rpage_t *blknums,
+	int nblocks,
+	int remote_port,
+	char *buffer
+)
+{
+	int ret = 0;
+
+	rmem_debug("writev() nodenum=%d nblocks=%d",
+		remote,
+		nblocks
+	);
+
+	/* Invalid list of blocks. */
+	if (!rmem_iov_is_valid(blknums, nblocks))
+	{
+		uprintf("[nanvix][rmem] invalid block number");
+		return (-EINVAL);
+	}
+
+	nanvix_semaphore_down(&rmem.inportal_lock);
+		uassert(kportal_allow(inportal, remote, remote_port) == 0);
+		uassert(
+			kportal_read(
+				inportal,
+				buffer,
+				nblocks*RMEM_BLOCK_SIZE
+			) == (ssize_t) (nblocks*RMEM_BLOCK_SIZE)
+		);
+	nanvix_semaphore_up(&rmem.inportal_lock);
+
+	/* Scatter blocks. */
+	for (int i = 0; i < nblocks; i++)
+	{
+		char *block;
+		rpage_t _blknum = RMEM_BLOCK_NUM(blknums[i]);
+
+		rmem_block_lock(_blknum);
+
+			/* Bad block number. */
+			if (!rmem_block_is_live(_blknum))
+			{
+				uprintf("[nanvix][rmem] bad write block");
+				ret = -EFAULT;
+			}
+			else if ((block = rmem_block_writable(_blknum, 1)) == NULL)
+			{
+				uprintf("[nanvix][rmem] remote memory full");
+				ret = -ENOMEM;
+			}
+			else
+				umemcpy(block, &buffer[i*RMEM_BLOCK_SIZE], RMEM_BLOCK_SIZE);
+
+		rmem_block_unlock(_blknum);
+	}
+
+	return (ret);
+}
+
+/*============================================================================*
+ * rmem_block_is_zero()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Checks if a block is all zeros.
+ *
+ * @param data Contents of the target block.
+ *
+ * @returns One if the target block is all zeros, and zero otherwise.
+ */
+static int rmem_block_is_zero(const char *data)
+{
+	for (size_t i = 0; i < RMEM_BLOCK_SIZE; i++)
+	{
+		if (data[i] != 0)
+			return (0);
+	}
+
+	return (1);
+}
+
+/*============================================================================*
+ * do_rmem_checkpoint()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Handles a checkpoint request.
+ *
+ * Blocks that changed since they were last checkpointed are gathered
+ * in a staging buffer, starting from a cursor, and sent to the remote
+ * client in a single portal transfer. The acknowledge carries a record
+ * for each block and the cursor to resume from. Each change is
+ * reported once, thus checkpoints that follow are incremental.
+ *
+ * @param remote  Remote client.
+ * @param cursor  Block to resume from.
+ * @param outbox  Output mailbox to remote client.
+ * @param tag     Tag of the request.
+ * @param outport Port of the input portal of the remote client.
+ * @param buffer  Staging buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_checkpoint(
+	int remote,
+	rpage_t cursor,
+	int outbox,
+	uint32_t tag,
+	int outport,
+	char *buffer
+)
+{
+	int ret = 0;
+	int n = 0;
+	int outportal;
+	rpage_t b;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+
+	rmem_debug("checkpoint() nodenum=%d cursor=%d", remote, cursor);
+
+	/* First block is special. */
+	for (b = ((cursor > 0) ? cursor : 1); (b < __RMEM_CAPACITY) && (n < RMEM_RECORDS_MAX); b++)
+	{
+		int dirty;
+		const char *block = zeros;
+
+		/* Skip clean words. */
+		spinlock_lock(&rmem.lock);
+			dirty = (rmem.dirty[IDX(b)] != 0);
+		spinlock_unlock(&rmem.lock);
+		if (!dirty)
+		{
+			b |= (BITMAP_WORD_LENGTH - 1);
+			continue;
+		}
+
+		rmem_block_lock(b);
+
+			spinlock_lock(&rmem.lock);
+				if ((dirty = bitmap_check_bit(rmem.dirty, b)))
+				{
+					bitmap_clear(rmem.dirty, b);
+					RMEM_RECORD_BLOCK(&msg, n) = RMEM_BLOCK(serverid, b);
+					RMEM_RECORD_OWNER(&msg, n) = rmem_block_is_live(b) ?
+						(rpage_t) rmem.owners[b] : RMEM_RECORD_FREE;
+				}
+			spinlock_unlock(&rmem.lock);
+
+			if (dirty)
+			{
+				if ((RMEM_RECORD_OWNER(&msg, n) != RMEM_RECORD_FREE) &&
+					((block = rmem_block_readable(b)) == NULL))
+				{
+					uprintf("[nanvix][rmem] remote memory full");
+					ret = -ENOMEM;
+					block = zeros;
+				}
+
+				umemcpy(&buffer[n*RMEM_BLOCK_SIZE], block, RMEM_BLOCK_SIZE);
+				n++;
+			}
+
+		rmem_block_unlock(b);
+	}
+
+	msg.nblocks = n;
+	msg.blknum = (b < __RMEM_CAPACITY) ? b : RMEM_NULL;
+	msg.flags = 0;
+
+	uassert((outportal = channel_portal_get(remote, outport)) >= 0);
+	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+	uassert(
+		kmailbox_write(outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == sizeof(struct rmem_message)
+	);
+	if (n > 0)
+	{
+		uassert(
+			kportal_write(
+				outportal,
+				buffer,
+				n*RMEM_BLOCK_SIZE
+			) == (ssize_t) (n*RMEM_BLOCK_SIZE)
+		);
+	}
+	channel_portal_put(outportal);
+
+	return (ret);
+}
+
+/*============================================================================*
+ * do_rmem_restore()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Handles a restore request.
+ *
+ * Records of a checkpoint are received in a staging buffer, in a
+ * single portal transfer, and then applied. Restored blocks are not
+ * reported by checkpoints that follow. Restores are accepted only
+ * until the first allocation of a block.
+ *
+ * @param remote      Remote client.
+ * @param msg         Target request, which carries a list of records.
+ * @param remote_port Port of the output portal of the remote client.
+ * @param buffer      Staging buffer.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_restore(
+	int remote,
+	const struct rmem_message *msg,
+	int remote_port,
+	char *buffer
+)
+{
+	int ret = 0;
+
+	rmem_debug("restore() nodenum=%d nblocks=%d", remote, msg->nblocks);
+
+	/* Invalid number of records. */
+	if ((msg->nblocks <= 0) || (msg->nblocks > RMEM_RECORDS_MAX))
+		return (-EINVAL);
+
+	/* Invalid block number. */
+	for (int i = 0; i < msg->nblocks; i++)
+	{
+		rpage_t _blknum = RMEM_BLOCK_NUM(RMEM_RECORD_BLOCK(msg, i));
+
+		if ((RMEM_BLOCK_SERVER(RMEM_RECORD_BLOCK(msg, i)) != (rpage_t) serverid) ||
+			(_blknum == RMEM_NULL) || (_blknum >= __RMEM_CAPACITY))
+		{
+			uprintf("[nanvix][rmem] invalid block number");
+			return (-EINVAL);
+		}
+	}
+
+	nanvix_semaphore_down(&rmem.inportal_lock);
+		uassert(kportal_allow(inportal, remote, remote_port) == 0);
+		uassert(
+			kportal_read(
+				inportal,
+				buffer,
+				msg->nblocks*RMEM_BLOCK_SIZE
+			) == (ssize_t) (msg->nblocks*RMEM_BLOCK_SIZE)
+		);
+	nanvix_semaphore_up(&rmem.inportal_lock);
+
+	/* Apply records. */
+	for (int i = 0; i < msg->nblocks; i++)
+	{
+		char *block;
+		const char *data = &buffer[i*RMEM_BLOCK_SIZE];
+		rpage_t owner = RMEM_RECORD_OWNER(msg, i);
+		rpage_t _blknum = RMEM_BLOCK_NUM(RMEM_RECORD_BLOCK(msg, i));
+
+		rmem_block_lock(_blknum);
+
+			spinlock_lock(&rmem.lock);
+
+				/* Server is live. */
+				if (!rmem.restorable)
+					ret = -EBUSY;
+
+				/* Freed block. */
+				else if (owner == RMEM_RECORD_FREE)
+				{
+					if (bitmap_check_bit(rmem.bitmap, _blknum))
+						rmem_block_release(_blknum);
+				}
+
+				else
+				{
+					if (!bitmap_check_bit(rmem.bitmap, _blknum))
+					{
+						stats.nblocks++;
+						rmem_bitmap_set(_blknum);
+					}
+					rmem.owners[_blknum] = owner;
+					rmem_frame_put(rmem.frames[_blknum]);
+					rmem.frames[_blknum] = RMEM_NULL;
+				}
+
+			spinlock_unlock(&rmem.lock);
+
+			/* Zero blocks are not backed. */
+			if ((ret == 0) && (owner != RMEM_RECORD_FREE) && !rmem_block_is_zero(data))
+			{
+				if ((block = rmem_block_writable(_blknum, 1)) == NULL)
+				{
+					uprintf("[nanvix][rmem] remote memory full");
+					ret = -ENOMEM;
+				}
+				else
+					umemcpy(block, data, RMEM_BLOCK_SIZE);
+			}
+
+			spinlock_lock(&rmem.lock);
+				bitmap_clear(rmem.dirty, _blknum);
+			spinlock_unlock(&rmem.lock);
+
+		rmem_block_unlock(_blknum);
+
+		/* Server is live. */
+		if (ret == -EBUSY)
+			break;
+	}
+
+	return (ret);
+}
+
+#endif
+
+/*============================================================================*
+ * do_rmem_prefetch()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Handles a request to set the prefetch depth of a client.
+ *
+ * @param remote Remote client.
+ * @param depth  Prefetch depth (zero disables prefetching).
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+static int do_rmem_prefetch(int remote, int depth)
+{
+#ifndef __RMEM_USES_MAILBOX
+	struct rmem_stream *stream;
+
+	rmem_debug("prefetch() nodenum=%d depth=%d", remote, depth);
+
+	/* Invalid depth. */
+	if ((depth < 0) || (depth > RMEM_PREFETCH_MAX))
+		return (-EINVAL);
+
+	/* Too many clients. */
+	if ((stream = rmem_stream_get(remote)) == NULL)
+		return (-ENOMEM);
+
+	stream->depth = depth;
+	stream->stride = 0;
+
+	return (0);
+#else
+	((void) remote);
+	((void) depth);
+
+	return (-ENOTSUP);
+#endif
+}
+
+/*============================================================================*
+ * do_rmem_stats()                                                            *
+ *============================================================================*/
+
+#ifndef __RMEM_USES_MAILBOX
+
+/**
+ * @brief Handles a statistics request.
+ *
+ * @param remote  Remote client.
+ * @param outbox  Output mailbox to remote client.
+ * @param tag     Tag of the request.
+ * @param outport Portal port of the remote client.
+ * @param buffer  Staging buffer.
+ */
+static void do_rmem_stats(int remote, int outbox, uint32_t tag, int outport, char *buffer)
+{
+	int outportal;
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+	msg.errcode = 0;
+
+	rmem_debug("stats() nodenum=%d", remote);
+
+	rmem_stats_snapshot(buffer);
+
+	uassert((outportal = channel_portal_get(remote, outport)) >= 0);
+	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
+	uassert(
+		kmailbox_write(outbox,
+			&msg,
+			sizeof(struct rmem_message)
+		) == sizeof(struct rmem_message)
+	);
+	uassert(
+		kportal_write(
+			outportal,
+			buffer,
+			sizeof(struct rmem_stats)
+		) == (ssize_t) sizeof(struct rmem_stats)
+	);
+	channel_portal_put(outportal);
+}
+
+#else
+
+/**
+ * @brief Handles a statistics request.
+ *
+ * @param outbox Output mailbox to remote client.
+ * @param tag    Tag of the request.
+ * @param buffer Staging buffer.
+ */
+static void do_rmem_stats(int outbox, uint32_t tag, char *buffer)
+{
+	struct rmem_message msg;
+
+	/* Build operation header. */
+	msg.header.source = knode_get_num();
+	msg.header.opcode = RMEM_ACK;
+	msg.tag = tag;
+	msg.errcode = 0;
+
+	rmem_debug("stats()");
+
+	rmem_stats_snapshot(buffer);
+
+	for (size_t i = 0; i < sizeof(struct rmem_stats); i += RMEM_PAYLOAD_SIZE)
+	{
+		msg.offset = i;
+		msg.size = ((sizeof(struct rmem_stats) - i) < RMEM_PAYLOAD_SIZE) ?
+			(sizeof(struct rmem_stats) - i) : RMEM_PAYLOAD_SIZE;
+
+		umemcpy(&msg.payload, &buffer[msg.offset], msg.size);
+
+		uassert(
+			kmailbox_write(
+				outbox,
+				&msg, sizeof(struct rmem_message)
+			) == sizeof(struct rmem_message)
+		);
+	}
 }
 
+#endif
+
 /*============================================================================*
- * do_rmem_write()                                                            *
+ * Write Windows                                                              *
  *============================================================================*/
 
-#ifndef __RMEM_USES_MAILBOX
+/**
+ * @brief Maximum number of write windows.
+ */
+#define RMEM_WINDOWS_NUM NANVIX_PROC_MAX
 
 /**
- * @brief Handles a write request.
+ * @brief Write windows of clients.
  *
- * @param remote Remote client.
- * @param blknum Number of the target block.
+ * Writes are acknowledged cumulatively. A window records the first
+ * error that was hit by a client since its last acknowledge, and the
+ * first error that was hit by its posted writes since its last fence.
+ * Like streams, a window is only touched by the thread that handles
+ * requests of its client.
  */
-static inline int do_rmem_write(int remote, rpage_t blknum, int remote_port)
+static struct rmem_window
 {
-	int ret = 0;
-	rpage_t _blknum;
-
-	rmem_debug("write() nodenum=%d blknum=%x",
-		remote,
-		blknum
-	);
+	int nodenum; /**< Client (negative if unused).   */
+	int errcode; /**< First error since last ack.    */
+	int posted;  /**< First error since last fence.  */
+} windows[RMEM_WINDOWS_NUM];
 
-	_blknum = RMEM_BLOCK_NUM(blknum);
+/**
+ * @brief Gets the write window of a client.
+ *
+ * @param remote Node number of the target client.
+ *
+ * @returns The write window of the target client is returned. If
+ * there is no room to track the target client, NULL is returned
+ * instead.
+ */
+static struct rmem_window *rmem_window_get(int remote)
+{
+	struct rmem_window *window = NULL;
 
-	/* Invalid block number. */
-	if ((_blknum == RMEM_NULL) || (_blknum >= RMEM_NUM_BLOCKS))
-	{
-		uprintf("[nanvix][rmem] invalid block number");
-		return (-EINVAL);
-	}
+	spinlock_lock(&rmem.lock);
 
-	/*
-	 * Bad block number. Drop this read and return
-	 * an error. Note that we use the NULL block for this.
-	 */
-	if (!bitmap_check_bit(rmem.bitmap, _blknum))
-	{
-		uprintf("[nanvix][rmem] bad write block");
-		_blknum = 0;
-		ret = -EFAULT;
-	}
+		for (int i = 0; i < RMEM_WINDOWS_NUM; i++)
+		{
+			if (windows[i].nodenum == remote)
+			{
+				window = &windows[i];
+				break;
+			}
+
+			/* Start tracking. */
+			if (windows[i].nodenum < 0)
+			{
+				windows[i].nodenum = remote;
+				windows[i].errcode = 0;
+				windows[i].posted = 0;
+				window = &windows[i];
+				break;
+			}
+		}
 
-	uassert(kportal_allow(inportal, remote, remote_port) == 0);
-	uassert(
-		kportal_read(
-			inportal,
-			&rmem.blocks[_blknum*RMEM_BLOCK_SIZE],
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
-	);
+	spinlock_unlock(&rmem.lock);
 
-	return (ret);
+	return (window);
 }
 
-#else
-
 /**
- * @brief Handles a write request.
+ * @brief Accounts a write.
  *
- * @param remote Remote client.
- * @param blknum Number of the target block.
+ * Posted writes are never replied. Over mailboxes, only chunks that
+ * carry the @p RMEM_FLAG_ACK flag are replied, and the error code of
+ * a reply is the first error that was hit since the last reply.
+ *
+ * @param msg Target write.
+ *
+ * @returns Non-zero if the target write should be replied, and zero
+ * otherwise.
  */
-static inline int do_rmem_write(rpage_t blknum, size_t offset, const char *payload)
+static int rmem_window_put(struct rmem_message *msg)
 {
-	int ret = 0;
-	rpage_t _blknum;
+	struct rmem_window *window;
 
-	rmem_debug("write() nodenum=%d blknum=%x",
-		remote,
-		blknum
-	);
+	/* Other writes over portals are replied with their own error. */
+#ifndef __RMEM_USES_MAILBOX
+	if (!(msg->flags & RMEM_FLAG_POSTED))
+		return (1);
+#endif
 
-	_blknum = RMEM_BLOCK_NUM(blknum);
+	window = rmem_window_get(msg->header.source);
 
-	/* Invalid block number. */
-	if ((_blknum == RMEM_NULL) || (_blknum >= RMEM_NUM_BLOCKS))
+	/* Posted write. */
+	if (msg->flags & RMEM_FLAG_POSTED)
 	{
-		uprintf("[nanvix][rmem] invalid block number");
-		return (-EINVAL);
+		if (msg->errcode < 0)
+		{
+			if (window == NULL)
+				uprintf("[nanvix][rmem] write error lost");
+			else if (window->posted == 0)
+				window->posted = msg->errcode;
+		}
+
+		return (0);
 	}
 
-	/*
-	 * Bad block number. Drop this read and return
-	 * an error. Note that we use the NULL block for this.
-	 */
-	if (!bitmap_check_bit(rmem.bitmap, _blknum))
+#ifdef __RMEM_USES_MAILBOX
+
+	/* No room to track the client. */
+	if (window == NULL)
 	{
-		uprintf("[nanvix][rmem] bad write block");
-		_blknum = 0;
-		ret = -EFAULT;
+		if ((msg->errcode < 0) && !(msg->flags & RMEM_FLAG_ACK))
+			uprintf("[nanvix][rmem] write error lost");
+
+		return (msg->flags & RMEM_FLAG_ACK);
 	}
 
-	umemcpy(
-		&rmem.blocks[_blknum*RMEM_BLOCK_SIZE + offset],
-		payload,
-		RMEM_PAYLOAD_SIZE
-	);
+	if ((msg->errcode < 0) && (window->errcode == 0))
+		window->errcode = msg->errcode;
 
-	return (ret);
-}
+	/* Not acknowledged. */
+	if (!(msg->flags & RMEM_FLAG_ACK))
+		return (0);
 
-#endif
+	msg->errcode = window->errcode;
+	window->errcode = 0;
 
-/*============================================================================*
- * do_rmem_read()                                                             *
- *============================================================================*/
+#endif
 
-#ifndef __RMEM_USES_MAILBOX
+	return (1);
+}
 
 /**
- * @brief Handles a read request.
+ * @brief Handles a fence.
  *
- * @param remote Remote client.
- * @param blknum Number of the target block.
- * @param outbox Output mailbox to remote client.
+ * Requests of a client are handled in order, thus all posted writes
+ * of the client were already applied.
  *
- * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * @param remote Node number of the target client.
+ *
+ * @returns The first error that was hit by posted writes of the
+ * target client since its last fence.
  */
-static inline int do_rmem_read(int remote, rpage_t blknum, int outbox, int outport)
+static int rmem_window_fence(int remote)
 {
-	int ret = 0;
-	int outportal;
-	rpage_t _blknum;
-	struct rmem_message msg;
+	int errcode;
+	struct rmem_window *window;
 
-	/* Build operation header. */
-	msg.header.source = knode_get_num();
-	msg.header.opcode = RMEM_ACK;
+	if ((window = rmem_window_get(remote)) == NULL)
+		return (0);
 
-	rmem_debug("read() nodenum=%d blknum=%x",
-		remote,
-		blknum
-	);
+	errcode = window->posted;
+	window->posted = 0;
 
-	_blknum = RMEM_BLOCK_NUM(blknum);
+	return (errcode);
+}
 
-	/* Invalid block number. */
-	if ((_blknum == RMEM_NULL) || (_blknum >= RMEM_NUM_BLOCKS))
-	{
-		uprintf("[nanvix][rmem] invalid block number");
-		return (-EINVAL);
-	}
+/*============================================================================*
+ * do_rmem_handle()                                                           *
+ *============================================================================*/
 
-	/*
-	 * Bad block number. Let us send a null block
-	 * and return an error instead.
-	 */
-	if (!bitmap_check_bit(rmem.bitmap, _blknum))
+/**
+ * @brief Handles a remote memory request.
+ *
+ * @param msg    Target request.
+ * @param buffer Staging buffer for vectored operations and statistics.
+ */
+static void do_rmem_handle(struct rmem_message *msg, char *buffer)
+{
+	int source;
+	uint64_t t0, t1;
+#ifndef __RMEM_USES_MAILBOX
+	int npushes;
+	rpage_t pushes[RMEM_PREFETCH_MAX];
+#endif
+
+	switch (msg->header.opcode)
 	{
-		uprintf("[nanvix][rmem] bad read block");
-		_blknum = 0;
-		ret = -EFAULT;
+		/* Write to RMEM. */
+		case RMEM_WRITE:
+			kclock(&t0);
+				if (msg->flags & RMEM_FLAG_ZERO)
+					msg->errcode = do_rmem_zero(msg->blknum);
+				else
+				#ifndef __RMEM_USES_MAILBOX
+					msg->errcode = do_rmem_write(msg->header.source, msg->blknum, 0, RMEM_BLOCK_SIZE, msg->header.portal_port);
+				#else
+					msg->errcode = do_rmem_write(msg->blknum, msg->offset, RMEM_PAYLOAD_SIZE, msg->payload);
+				#endif
+				if (rmem_window_put(msg))
+				{
+					uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+					uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+					channel_mailbox_put(source);
+				}
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Read a page. */
+		case RMEM_READ:
+			kclock(&t0);
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				#ifndef __RMEM_USES_MAILBOX
+				if ((npushes = rmem_stream_predict(msg->header.source, msg->blknum, pushes)) > 0)
+					msg->errcode = do_rmem_read_ahead(msg->header.source, msg->blknum, pushes, npushes, source, msg->tag, msg->header.portal_port, buffer);
+				else
+					msg->errcode = do_rmem_read(msg->header.source, msg->blknum, 0, RMEM_BLOCK_SIZE, source, msg->tag, msg->header.portal_port);
+				#else
+				msg->errcode = do_rmem_read(msg->blknum, 0, RMEM_BLOCK_SIZE, source, msg->tag);
+				#endif
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Write to part of a block. */
+		case RMEM_WRITE_PARTIAL:
+			kclock(&t0);
+				#ifndef __RMEM_USES_MAILBOX
+				msg->errcode = do_rmem_write(msg->header.source, msg->blknum, msg->offset, msg->size, msg->header.portal_port);
+				#else
+				msg->errcode = do_rmem_write(msg->blknum, msg->offset, msg->size, msg->payload);
+				#endif
+				if (rmem_window_put(msg))
+				{
+					uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+					uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+					channel_mailbox_put(source);
+				}
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Read part of a block. */
+		case RMEM_READ_PARTIAL:
+			kclock(&t0);
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				#ifndef __RMEM_USES_MAILBOX
+				msg->errcode = do_rmem_read(msg->header.source, msg->blknum, msg->offset, msg->size, source, msg->tag, msg->header.portal_port);
+				#else
+				msg->errcode = do_rmem_read(msg->blknum, msg->offset, msg->size, source, msg->tag);
+				#endif
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+	#ifndef __RMEM_USES_MAILBOX
+
+		/* Write to many blocks. */
+		case RMEM_WRITEV:
+			kclock(&t0);
+				msg->errcode = do_rmem_writev(msg->header.source, msg->blknums, msg->nblocks, msg->header.portal_port, buffer);
+				if (rmem_window_put(msg))
+				{
+					uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+					uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+					channel_mailbox_put(source);
+				}
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Read many blocks. */
+		case RMEM_READV:
+			kclock(&t0);
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				msg->errcode = do_rmem_readv(msg->header.source, msg->blknums, msg->nblocks, source, msg->tag, msg->header.portal_port, buffer);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Checkpoints changed blocks. */
+		case RMEM_CHECKPOINT:
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			msg->errcode = do_rmem_checkpoint(msg->header.source, msg->blknum, source, msg->tag, msg->header.portal_port, buffer);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+		/* Restores blocks. */
+		case RMEM_RESTORE:
+			msg->errcode = do_rmem_restore(msg->header.source, msg, msg->header.portal_port, buffer);
+			msg->nfree = rmem_nfree();
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+	#endif
+
+		/* Allocates a page. */
+		case RMEM_ALLOC:
+			kclock(&t0);
+				msg->blknum = do_rmem_alloc(msg->header.source);
+				msg->errcode = (msg->blknum == RMEM_NULL) ? RMEM_NULL : msg->blknum;
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Free frees a page. */
+		case RMEM_MEMFREE:
+			kclock(&t0);
+				msg->errcode = do_rmem_free(msg->blknum, msg->header.source);
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Allocates many pages. */
+		case RMEM_ALLOC_N:
+			kclock(&t0);
+				msg->errcode = do_rmem_alloc_n(msg, msg->header.source);
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Frees many pages. */
+		case RMEM_FREE_N:
+			kclock(&t0);
+				msg->errcode = do_rmem_free_n(msg, msg->header.source);
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Clones a page. */
+		case RMEM_CLONE:
+			kclock(&t0);
+				msg->blknum = do_rmem_clone(msg->blknum, msg->header.source);
+				msg->errcode = (msg->blknum == RMEM_NULL) ? -ENOMEM : 0;
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Frees all pages of an owner. */
+		case RMEM_FREE_ALL:
+			kclock(&t0);
+				msg->nblocks = do_rmem_free_all(msg->header.source);
+				msg->errcode = 0;
+				msg->nfree = rmem_nfree();
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Sets prefetch depth. */
+		case RMEM_PREFETCH:
+			msg->errcode = do_rmem_prefetch(msg->header.source, msg->nblocks);
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+		/* Queries geometry. */
+		case RMEM_INFO:
+			msg->size = RMEM_BLOCK_SIZE;
+			msg->nblocks = __RMEM_CAPACITY;
+			msg->nfree = rmem_nfree();
+			msg->errcode = 0;
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+		/* Atomic operations. */
+		case RMEM_ATOMIC_ADD:
+		case RMEM_ATOMIC_CAS:
+		case RMEM_ATOMIC_SWAP:
+		case RMEM_ATOMIC_OR:
+			kclock(&t0);
+				msg->errcode = do_rmem_atomic(
+					msg->header.opcode,
+					msg->blknum,
+					msg->offset,
+					&msg->atomic.value,
+					msg->atomic.expected
+				);
+				uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+				uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+				channel_mailbox_put(source);
+			kclock(&t1);
+			rmem_stats_record(msg, t1 - t0);
+			break;
+
+		/* Waits for posted writes. */
+		case RMEM_FENCE:
+			msg->errcode = rmem_window_fence(msg->header.source);
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+		/* Migrates a page. */
+		case RMEM_MIGRATE:
+			msg->errcode = do_rmem_migrate(msg->blknum, msg->blknums[0], msg->header.source);
+			msg->nfree = rmem_nfree();
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+			uassert(kmailbox_write(source, msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
+			channel_mailbox_put(source);
+			break;
+
+		/* Queries statistics. */
+		case RMEM_STATS:
+			uassert((source = channel_mailbox_get(msg->header.source, msg->header.mailbox_port)) >= 0);
+		#ifndef __RMEM_USES_MAILBOX
+			do_rmem_stats(msg->header.source, source, msg->tag, msg->header.portal_port, buffer);
+		#else
+			do_rmem_stats(source, msg->tag, buffer);
+		#endif
+			channel_mailbox_put(source);
+			break;
+
+		/* Should not happen. */
+		default:
+			break;
 	}
+}
 
-	uassert((outportal =
-		kportal_open(
-			knode_get_num(),
-			remote,
-			outport)
-		) >= 0
-	);
-	msg.header.portal_port = kcomm_get_port(outportal, COMM_TYPE_PORTAL);
-	uassert(
-		kmailbox_write(outbox,
-			&msg,
-			sizeof(struct rmem_message)
-		) == sizeof(struct rmem_message)
-	);
-	uassert(
-		kportal_write(
-			outportal,
-			&rmem.blocks[_blknum*RMEM_BLOCK_SIZE],
-			RMEM_BLOCK_SIZE
-		) == RMEM_BLOCK_SIZE
-	);
-	uassert(kportal_close(outportal) == 0);
+/*============================================================================*
+ * Worker Threads                                                             *
+ *============================================================================*/
 
-	return (ret);
+#if (__RMEM_WORKERS_NUM > 0)
+
+/**
+ * @brief Worker thread.
+ *
+ * Each worker owns a bounded request queue, which is filled by the
+ * dispatcher thread and drained by the worker itself. Requests of a
+ * client are always dispatched to the same worker, thus they are
+ * handled in the order that they were issued.
+ */
+static struct rmem_worker
+{
+	kthread_t tid;                                 /**< Thread ID.          */
+	unsigned head;                                 /**< Head of queue.      */
+	unsigned tail;                                 /**< Tail of queue.      */
+	struct nanvix_semaphore nslots;                /**< Free slots.         */
+	struct nanvix_semaphore nrequests;             /**< Pending requests.   */
+	struct rmem_message queue[RMEM_QUEUE_LENGTH];  /**< Request queue.      */
+	char buffer[RMEM_IOV_MAX*RMEM_BLOCK_SIZE];     /**< Staging buffer.     */
+} workers[__RMEM_WORKERS_NUM];
+
+/**
+ * @brief Enqueues a request in a worker thread.
+ *
+ * @param worker Target worker.
+ * @param msg    Target request.
+ */
+static void rmem_worker_put(struct rmem_worker *worker, const struct rmem_message *msg)
+{
+	/* Sample queue depth. */
+	rmem_stats_depth(worker->tail - worker->head);
+
+	nanvix_semaphore_down(&worker->nslots);
+		umemcpy(&worker->queue[worker->tail % RMEM_QUEUE_LENGTH], msg, sizeof(struct rmem_message));
+		worker->tail++;
+	nanvix_semaphore_up(&worker->nrequests);
 }
 
-#else
+/**
+ * @brief Dequeues a request from a worker thread.
+ *
+ * @param worker Target worker.
+ * @param msg    Location to store the request.
+ */
+static void rmem_worker_get(struct rmem_worker *worker, struct rmem_message *msg)
+{
+	nanvix_semaphore_down(&worker->nrequests);
+		umemcpy(msg, &worker->queue[worker->head % RMEM_QUEUE_LENGTH], sizeof(struct rmem_message));
+		worker->head++;
+	nanvix_semaphore_up(&worker->nslots);
+}
 
 /**
- * @brief Handles a read request.
+ * @brief Handles remote memory requests in a worker thread.
  *
- * @param remote Remote client.
- * @param blknum Number of the target block.
- * @param outbox Output mailbox to remote client.
+ * @param args Target worker.
  *
- * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * @returns Always returns NULL.
  */
-static inline int do_rmem_read(rpage_t blknum, int outbox)
+static void *rmem_worker(void *args)
 {
-	int ret = 0;
-	rpage_t _blknum;
 	struct rmem_message msg;
+	struct rmem_worker *worker = args;
 
-	/* Build operation header. */
-	msg.header.source = knode_get_num();
-	msg.header.opcode = RMEM_ACK;
-	msg.blknum = blknum;
-
-	rmem_debug("read() nodenum=%d blknum=%x",
-		remote,
-		blknum
-	);
+	do
+	{
+		rmem_worker_get(worker, &msg);
+		do_rmem_handle(&msg, worker->buffer);
+	} while (msg.header.opcode != RMEM_EXIT);
 
-	_blknum = RMEM_BLOCK_NUM(blknum);
+	return (NULL);
+}
 
-	/* Invalid block number. */
-	if ((_blknum == RMEM_NULL) || (_blknum >= RMEM_NUM_BLOCKS))
-	{
-		uprintf("[nanvix][rmem] invalid block number");
-		return (-EINVAL);
-	}
+/**
+ * @brief Spawns worker threads.
+ */
+static void rmem_workers_start(void)
+{
+	/* Dispatcher thread runs in a thread as well. */
+	uassert(__RMEM_WORKERS_NUM < THREAD_MAX);
 
-	/*
-	 * Bad block number. Let us send a null block
-	 * and return an error instead.
-	 */
-	if (!bitmap_check_bit(rmem.bitmap, _blknum))
+	for (int i = 0; i < __RMEM_WORKERS_NUM; i++)
 	{
-		uprintf("[nanvix][rmem] bad read block");
-		_blknum = 0;
-		ret = -EFAULT;
+		workers[i].head = 0;
+		workers[i].tail = 0;
+		nanvix_semaphore_init(&workers[i].nslots, RMEM_QUEUE_LENGTH);
+		nanvix_semaphore_init(&workers[i].nrequests, 0);
+		uassert(kthread_create(&workers[i].tid, rmem_worker, &workers[i]) == 0);
 	}
+}
 
-	for (size_t i = 0; i < RMEM_BLOCK_SIZE; i += RMEM_PAYLOAD_SIZE)
-	{
-		msg.offset = i;
+/**
+ * @brief Terminates worker threads.
+ */
+static void rmem_workers_stop(void)
+{
+	struct rmem_message msg;
 
-		umemcpy(
-			&msg.payload,
-			&rmem.blocks[_blknum*RMEM_BLOCK_SIZE + i],
-			RMEM_PAYLOAD_SIZE
-		);
+	msg.header.opcode = RMEM_EXIT;
 
-		uassert(
-			kmailbox_write(
-				outbox,
-				&msg, sizeof(struct rmem_message)
-			) == sizeof(struct rmem_message)
-		);
+	for (int i = 0; i < __RMEM_WORKERS_NUM; i++)
+	{
+		rmem_worker_put(&workers[i], &msg);
+		uassert(kthread_join(workers[i].tid, NULL) == 0);
 	}
-
-	return (ret);
 }
 
 #endif
@@ -517,13 +3780,11 @@ static inline int do_rmem_read(rpage_t blknum, int outbox)
 static int do_rmem_loop(void)
 {
 	int shutdown = 0;
-	uint64_t t0, t1;
 
 	kclock(&stats.tstart);
 
 	while(!shutdown)
 	{
-		int source;
 		struct rmem_message msg;
 
 		uassert(
@@ -540,77 +3801,25 @@ static int do_rmem_loop(void)
 			msg.header.opcode
 		);
 
-		/* handle write operation. */
-		switch (msg.header.opcode)
+		if (msg.header.opcode == RMEM_EXIT)
 		{
-			/* Write to RMEM. */
-			case RMEM_WRITE:
-				stats.nwrites++;
-				kclock(&t0);
-					#ifndef __RMEM_USES_MAILBOX
-					msg.errcode = do_rmem_write(msg.header.source, msg.blknum, msg.header.portal_port);
-					#else
-					msg.errcode = do_rmem_write(msg.blknum, msg.offset, msg.payload);
-					#endif
-					uassert((source = kmailbox_open(msg.header.source, msg.header.mailbox_port)) >= 0);
-					uassert(kmailbox_write(source, &msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
-					uassert(kmailbox_close(source) == 0);
-				kclock(&t1);
-				stats.twrite += (t1 - t0);
-				break;
-
-			/* Read a page. */
-			case RMEM_READ:
-				stats.nreads++;
-				kclock(&t0);
-					uassert((source = kmailbox_open(msg.header.source, msg.header.mailbox_port)) >= 0);
-					#ifndef __RMEM_USES_MAILBOX
-					msg.errcode = do_rmem_read(msg.header.source, msg.blknum, source, msg.header.portal_port);
-					#else
-					msg.errcode = do_rmem_read(msg.blknum, source);
-					#endif
-					uassert(kmailbox_write(source, &msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
-					uassert(kmailbox_close(source) == 0);
-				kclock(&t1);
-				stats.tread += (t1 - t0);
-				break;
-
-			/* Allocates a page. */
-			case RMEM_ALLOC:
-				stats.nallocs++;
-				kclock(&t0);
-					msg.blknum = do_rmem_alloc(msg.header.source);
-					msg.errcode = (msg.blknum == RMEM_NULL) ? RMEM_NULL : msg.blknum;
-					uassert((source = kmailbox_open(msg.header.source, msg.header.mailbox_port)) >= 0);
-					uassert(kmailbox_write(source, &msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
-					uassert(kmailbox_close(source) == 0);
-				kclock(&t1);
-				stats.talloc += (t1 - t0);
-			    break;
-
-			/* Free frees a page. */
-			case RMEM_MEMFREE:
-				stats.nfrees++;
-				kclock(&t0);
-					msg.errcode = do_rmem_free(msg.blknum, msg.header.source);
-					uassert((source = kmailbox_open(msg.header.source, msg.header.mailbox_port)) >= 0);
-					uassert(kmailbox_write(source, &msg, sizeof(struct rmem_message)) == sizeof(struct rmem_message));
-					uassert(kmailbox_close(source) == 0);
-				kclock(&t1);
-				stats.tfree += (t1 - t0);
-			    break;
-
-			case RMEM_EXIT:
-				kclock(&stats.tshutdown);
-				shutdown = 1;
-				break;
-
-			/* Should not happen. */
-			default:
-				break;
+			kclock(&stats.tshutdown);
+			shutdown = 1;
+			continue;
 		}
+
+	#if (__RMEM_WORKERS_NUM > 0)
+		rmem_worker_put(&workers[msg.header.source % __RMEM_WORKERS_NUM], &msg);
+	#else
+		do_rmem_handle(&msg, staging);
+	#endif
 	}
 
+#if (__RMEM_WORKERS_NUM > 0)
+	/* Drain requests that are still queued. */
+	rmem_workers_stop();
+#endif
+
 	/* Dump statistics. */
 	uprintf("[nanvix][rmem] nallocs=%d nfrees=%d nreads=%d nwrites=%d",
 			stats.nallocs, stats.nfrees,
@@ -651,34 +3860,97 @@ static int do_rmem_startup(struct nanvix_semaphore *lock)
 	/* Payload should have a good size. */
 #ifdef __RMEM_USES_MAILBOX
 	uassert((RMEM_BLOCK_SIZE%RMEM_PAYLOAD_SIZE) == 0);
+	uassert((RMEM_WINDOW_LENGTH > 0) && ((RMEM_WINDOW_LENGTH%2) == 0));
 #endif
 
 	/* Bitmap word should be large enough. */
 	uassert(sizeof(rpage_t) >= sizeof(bitmap_t));
 
+	/* Statistics should fit in the staging buffer. */
+	uassert(sizeof(struct rmem_stats) <= RMEM_IOV_MAX*RMEM_BLOCK_SIZE);
+
 	/* Physical memory should be big enough. */
 	uassert(RMEM_SIZE <=  UMEM_SIZE);
 	uassert((RMEM_SIZE%PAGE_SIZE) == 0);
 
-	/* Allocate physical memory. */
+	/*
+	 * Physical memory is allocated on demand,
+	 * upon the first write to a block.
+	 */
 	rmem.blocks = (char *) RMEM_START;
-	for (vaddr_t vaddr = RMEM_START; vaddr < RMEM_END; vaddr += PAGE_SIZE)
-		uassert(page_alloc(vaddr) == 0);
+#ifdef __RMEM_USES_COMPRESSION
+	rmem.zpool = rmem.blocks + RMEM_NUM_SLOTS*RMEM_BLOCK_SIZE;
+#endif
 
-	/* Clean bitmap. */
+	/* Clean bitmaps. */
 	umemset(
 		rmem.bitmap,
 		0,
 		(RMEM_NUM_BLOCKS/BITMAP_WORD_LENGTH)*sizeof(bitmap_t)
 	);
+	umemset(rmem.summary, 0, RMEM_SUMMARY_LENGTH*sizeof(bitmap_t));
+	umemset(rmem.dirty, 0, RMEM_BITMAP_LENGTH*sizeof(bitmap_t));
+	rmem.cursor = 0;
+	rmem.restorable = 1;
+	umemset(rmem.framemap, 0, RMEM_BITMAP_LENGTH*sizeof(bitmap_t));
+	umemset(rmem.frames, 0, RMEM_NUM_BLOCKS*sizeof(rpage_t));
+	umemset(rmem.forwards, 0, RMEM_NUM_BLOCKS*sizeof(rpage_t));
+	umemset(rmem.refcounts, 0, RMEM_NUM_BLOCKS*sizeof(uint16_t));
+	umemset(
+		rmem.backed,
+		0,
+		(RMEM_NUM_PAGES/BITMAP_WORD_LENGTH)*sizeof(bitmap_t)
+	);
+	umemset(
+		rmem.backing,
+		0,
+		(RMEM_NUM_PAGES/BITMAP_WORD_LENGTH)*sizeof(bitmap_t)
+	);
 
-	/* Fist block is special. */
-	stats.nblocks++;
-	bitmap_set(rmem.bitmap, 0);
+	/* Blocks beyond capacity are never handed out. */
+	for (rpage_t i = (__RMEM_CAPACITY/BITMAP_WORD_LENGTH); i < RMEM_BITMAP_LENGTH; i++)
+	{
+		rmem.bitmap[i] = BITMAP_FULL;
+		bitmap_set(rmem.summary, i);
+	}
+
+#ifdef __RMEM_USES_COMPRESSION
+	umemset(rmem.slotmap, 0, sizeof(rmem.slotmap));
+	umemset(rmem.recent, 0, sizeof(rmem.recent));
+	umemset(rmem.zmap, 0, sizeof(rmem.zmap));
+	umemset(rmem.pins, 0, sizeof(rmem.pins));
+	umemset(rmem.pinned, 0, sizeof(rmem.pinned));
+	rmem.hand = 0;
+	rmem.zcursor = 0;
+#endif
+
+	/* No client is tracked yet. */
+	for (int i = 0; i < RMEM_STATS_OWNERS; i++)
+		counters.owners[i].nodenum = -1;
+#ifndef __RMEM_USES_MAILBOX
+	for (int i = 0; i < RMEM_STREAMS_NUM; i++)
+		streams[i].nodenum = -1;
+#endif
+	for (int i = 0; i < RMEM_WINDOWS_NUM; i++)
+		windows[i].nodenum = -1;
+
+	/* Initialize locks. */
+	spinlock_init(&stats_lock);
+	spinlock_init(&rmem.lock);
+	nanvix_semaphore_init(&rmem.inportal_lock, 1);
+	for (int i = 0; i < RMEM_LOCKS_NUM; i++)
+		nanvix_semaphore_init(&rmem.locks[i], 1);
 
-	/* Clean all blocks. */
-	for (unsigned long i = 0; i < RMEM_NUM_BLOCKS; i++)
-		umemset(&rmem.blocks[i*RMEM_BLOCK_SIZE], 0, RMEM_BLOCK_SIZE);
+	/*
+	 * Fist block is special. It absorbs bad
+	 * writes, thus it is always backed. Its
+	 * frame is never assigned to other blocks.
+	 */
+	stats.nblocks++;
+	rmem_bitmap_set(0);
+	spinlock_lock(&rmem.lock);
+		uassert(rmem_frame_alloc(0) == 0);
+	spinlock_unlock(&rmem.lock);
 
 	nodenum = knode_get_num();
 
@@ -690,6 +3962,8 @@ static int do_rmem_startup(struct nanvix_semaphore *lock)
 
 	serverid = rmem_server_get_id();
 
+	channels_setup();
+
 	/* Link name. */
 	servername = rmem_server_get_name();
 	if ((ret = name_link(nodenum, servername)) < 0)
@@ -701,6 +3975,15 @@ static int do_rmem_startup(struct nanvix_semaphore *lock)
 	uprintf("[nanvix][rmem] listening to mailbox %d", inbox);
 	uprintf("[nanvix][rmem] listening to portal %d", inportal);
 	uprintf("[nanvix][rmem] memory size %d KB", RMEM_SIZE/KB);
+	uprintf("[nanvix][rmem] serving %d blocks of %d bytes", __RMEM_CAPACITY, RMEM_BLOCK_SIZE);
+#ifdef __RMEM_USES_COMPRESSION
+	uprintf("[nanvix][rmem] compressed pool size %d KB", RMEM_ZPOOL_SIZE/KB);
+#endif
+
+#if (__RMEM_WORKERS_NUM > 0)
+	rmem_workers_start();
+	uprintf("[nanvix][rmem] running %d workers", __RMEM_WORKERS_NUM);
+#endif
 
 	nanvix_semaphore_up(lock);
 
@@ -719,6 +4002,8 @@ static int do_rmem_startup(struct nanvix_semaphore *lock)
  */
 static int do_rmem_shutdown(void)
 {
+	channels_cleanup();
+
 	return (0);
 }
 
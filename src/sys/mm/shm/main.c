@@ -27,6 +27,7 @@
 
 #include <nanvix/servers/shm.h>
 #include <nanvix/servers/connection.h>
+#include <nanvix/servers/channel.h>
 #include <nanvix/runtime/stdikc.h>
 #include <nanvix/sys/semaphore.h>
 #include <nanvix/sys/mailbox.h>
@@ -211,9 +212,9 @@ static int do_inval(struct shm_message *request, struct shm_message *response)
 		msg.op.inval.page = page;
 
 		uassert((
-			outbox = kmailbox_open(
+			outbox = channel_mailbox_get(
 				remotes[i],
-				NANVIX_SHM_SNOOPER_PORT_NUM	
+				NANVIX_SHM_SNOOPER_PORT_NUM
 			)) >= 0
 		);
 		uassert(
@@ -223,7 +224,7 @@ static int do_inval(struct shm_message *request, struct shm_message *response)
 				sizeof(struct shm_message
 			)) == sizeof(struct shm_message)
 		);
-		uassert(kmailbox_close(outbox) == 0);
+		channel_mailbox_put(outbox);
 	}
 
 	response->op.ret.status = 0;
@@ -321,7 +322,7 @@ static int do_shm_loop(void)
 		);
 
 		uassert((
-			outbox = kmailbox_open(
+			outbox = channel_mailbox_get(
 				request.header.source,
 				request.header.mailbox_port
 			)) >= 0
@@ -333,7 +334,7 @@ static int do_shm_loop(void)
 				sizeof(struct shm_message
 			)) == sizeof(struct shm_message)
 		);
-		uassert(kmailbox_close(outbox) == 0);
+		channel_mailbox_put(outbox);
 	}
 
 	return (0);
@@ -365,6 +366,7 @@ static int do_shm_startup(struct nanvix_semaphore *lock)
 
 	shm_init();
 	connections_setup();
+	channels_setup();
 
 	uprintf("[nanvix][shm] server alive");
 	uprintf("[nanvix][shm] attached to node %d", server.nodenum);
@@ -389,6 +391,7 @@ static int do_shm_startup(struct nanvix_semaphore *lock)
 static int do_shm_shutdown(void)
 {
 	uprintf("[nanvix][shm] shutting down server");
+	channels_cleanup();
 
 	return (0);
 }
@@ -28,6 +28,7 @@
 
 #include <nanvix/limits/pm.h>
 #include <nanvix/runtime/stdikc.h>
+#include <nanvix/servers/channel.h>
 #include <nanvix/servers/message.h>
 #include <nanvix/servers/name.h>
 #include <nanvix/sys/semaphore.h>
@@ -94,6 +95,8 @@ static void do_name_init(struct nanvix_semaphore *lock)
 
 	uassert((inbox = stdinbox_get()) >= 0);
 
+	channels_setup();
+
 	/* Unblock spawner. */
 	uprintf("[nanvix][name] server alive");
 	uprintf("[nanvix][name] listening to mailbox %d", inbox);
@@ -381,7 +384,7 @@ int do_name_server(struct nanvix_semaphore *lock)
 		);
 
 		uassert((
-			outbox = kmailbox_open(
+			outbox = channel_mailbox_get(
 				request.header.source,
 				request.header.mailbox_port
 			)) >= 0
@@ -393,9 +396,11 @@ int do_name_server(struct nanvix_semaphore *lock)
 				sizeof(struct name_message
 			)) == sizeof(struct name_message)
 		);
-		uassert(kmailbox_close(outbox) == 0);
+		channel_mailbox_put(outbox);
 	}
 
+	channels_cleanup();
+
 	/* Dump statistics. */
 	uprintf("[nanvix][name] links=%d lookups=%d unlinks=%d",
 			stats.nlinks, stats.nlookups, stats.nunlinks
@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#define __NEED_MM_RMEM_STUB
+
 #include <nanvix/runtime/runtime.h>
 #include <nanvix/pm.h>
 #include <nanvix/ulib.h>
@@ -63,6 +65,11 @@ int __main2(int argc, const char *argv[])
 		test_vfs();
 
 		uprintf("[nanvix][test] shutting down server");
+
+		/* Release remote memory before servers shut down. */
+		if (nanvix_rmem_free_all() < 0)
+			uprintf("[nanvix][rmem] cannot release remote memory blocks");
+
 		uassert(stdsync_fence() == 0);
 
 	nanvix_shutdown();
@@ -95,6 +95,40 @@ static void test_stress_mem_read_write(void)
 	nanvix_free(ptr);
 }
 
+/*============================================================================*
+ * Stress Test: Readahead                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Stress Test: Readahead
+ *
+ * Faults on mapped pages after a sequential scan, while the page cache
+ * reads ahead.
+ */
+static void test_stress_mem_readahead(void)
+{
+	unsigned char *ptr;
+	unsigned size = 2*RMEM_CACHE_SIZE*PAGE_SIZE;
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_LRU) == 0);
+	TEST_ASSERT(nanvix_rcache_select_readahead(RMEM_CACHE_READAHEAD_MAX) == 0);
+
+	/* Allocate twice the size of the cache (in bytes). */
+	TEST_ASSERT((ptr = nanvix_malloc(size)) != NULL);
+
+	/* Sequential scan. */
+	for (unsigned i = 0; i < size; i++)
+		ptr[i] = i % (UCHAR_MAX + 1);
+
+	/* Fault on pages that were mapped last. */
+	for (unsigned i = size; i > 0; i--)
+		TEST_ASSERT(ptr[i - 1] == (i - 1) % (UCHAR_MAX + 1));
+
+	nanvix_free(ptr);
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_BYPASS) == 0);
+}
+
 /*============================================================================*/
 
 /**
@@ -104,5 +138,6 @@ struct test tests_mem_api[] = {
 	{ test_api_mem_alloc_free,    "memory alloc/free" },
 	{ test_api_mem_read_write,    "memory read/write" },
 	{ test_stress_mem_read_write, "stress read/write" },
+	{ test_stress_mem_readahead,  "stress readahead " },
 	{ NULL,                       NULL                },
 };
@@ -22,12 +22,23 @@
  * SOFTWARE.
  */
 
+#define __NEED_MM_RMEM_STUB
 #define __NEED_MM_RMEM_CACHE
 
 #include <nanvix/runtime/mm.h>
 #include <nanvix/ulib.h>
 #include "../../test.h"
 
+/**
+ * @brief Run replacement policies benchmark?
+ */
+#define __BENCHMARK_REPLACEMENT 0
+
+/**
+ * @brief Run readahead benchmark?
+ */
+#define __BENCHMARK_READAHEAD 0
+
 /**
  * @brief Number of blocks to allocate.
  */
@@ -85,6 +96,7 @@ static void test_rmem_rcache_consistency2(void)
 		for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
 			cached_data[j] = (i - 1)*RMEM_NUM_BLOCKS + j;
 
+		TEST_ASSERT(nanvix_rcache_put(numbers[i - 1], 0) == 0);
 	}
 
 	for (unsigned i = 1; i <= NUM_BLOCKS; i++)
@@ -98,6 +110,349 @@ static void test_rmem_rcache_consistency2(void)
 	}
 }
 
+/*============================================================================*
+ * Stress Test: Dirty Eviction                                                *
+ *============================================================================*/
+
+/**
+ * @brief Number of blocks to allocate in the dirty eviction test.
+ *
+ * Enough blocks are touched so that every set of the page cache
+ * sees evictions.
+ */
+#define NUM_DIRTY_BLOCKS (4*RMEM_CACHE_SIZE + 2)
+
+/**
+ * @brief Stress Test: Dirty Eviction
+ *
+ * Checks that only modified pages are written back on eviction.
+ */
+static void test_rmem_rcache_dirty(void)
+{
+	unsigned *cached_data;
+	static unsigned buffer[RMEM_BLOCK_SIZE/sizeof(unsigned)];
+	static rpage_t numbers[NUM_DIRTY_BLOCKS];
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_LRU) == 0);
+	nanvix_rcache_clean();
+
+	for (unsigned i = 0; i < NUM_DIRTY_BLOCKS; i++)
+		TEST_ASSERT((numbers[i] = nanvix_rcache_alloc()) != RMEM_NULL);
+
+	/* Modify the first page. */
+	TEST_ASSERT((cached_data = nanvix_rcache_get(numbers[0])) != NULL);
+	for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+		cached_data[j] = 1;
+	TEST_ASSERT(nanvix_rcache_put(numbers[0], 0) == 0);
+
+	/* Read the second page, then update it behind the cache. */
+	TEST_ASSERT(nanvix_rcache_read(numbers[1], buffer, 0, sizeof(unsigned)) == sizeof(unsigned));
+	for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+		buffer[j] = 2;
+	TEST_ASSERT(nanvix_rmem_write(numbers[1], buffer) == RMEM_BLOCK_SIZE);
+
+	/* Evict both pages. */
+	for (unsigned i = 2; i < NUM_DIRTY_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rcache_read(numbers[i], buffer, 0, sizeof(unsigned)) == sizeof(unsigned));
+	TEST_ASSERT(nanvix_rmem_fence() == 0);
+
+	/* Dirty page was written back. */
+	TEST_ASSERT(nanvix_rmem_read(numbers[0], buffer) == RMEM_BLOCK_SIZE);
+	for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+		TEST_ASSERT(buffer[j] == 1);
+
+	/* Clean page was dropped. */
+	TEST_ASSERT(nanvix_rmem_read(numbers[1], buffer) == RMEM_BLOCK_SIZE);
+	for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+		TEST_ASSERT(buffer[j] == 2);
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_BYPASS) == 0);
+	nanvix_rcache_clean();
+
+	for (unsigned i = 0; i < NUM_DIRTY_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rcache_free(numbers[i]) == 0);
+}
+
+/*============================================================================*
+ * Stress Test: Readahead                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Scans pages through the page cache and checks their contents.
+ *
+ * @param numbers Target pages.
+ * @param n       Number of target pages.
+ * @param stride  Stride of the scan.
+ */
+static void rcache_scan(const rpage_t *numbers, unsigned n, unsigned stride)
+{
+	unsigned *cached_data;
+
+	for (unsigned k = 0, i = 0; k < n; k++, i = (i + stride) % n)
+	{
+		TEST_ASSERT((cached_data = nanvix_rcache_get(numbers[i])) != NULL);
+
+		for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+			TEST_ASSERT(cached_data[j] == i*RMEM_NUM_BLOCKS + j);
+
+		TEST_ASSERT(nanvix_rcache_put(numbers[i], 0) == 0);
+	}
+}
+
+/**
+ * @brief Stress Test: Readahead
+ *
+ * Checks that pages read ahead are consistent on sequential and
+ * strided scans.
+ */
+static void test_rmem_rcache_readahead(void)
+{
+	static unsigned buffer[RMEM_BLOCK_SIZE/sizeof(unsigned)];
+	static rpage_t numbers[NUM_BLOCKS];
+
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+	{
+		TEST_ASSERT((numbers[i] = nanvix_rcache_alloc()) != RMEM_NULL);
+
+		for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+			buffer[j] = i*RMEM_NUM_BLOCKS + j;
+		TEST_ASSERT(nanvix_rmem_write(numbers[i], buffer) == RMEM_BLOCK_SIZE);
+	}
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_LRU) == 0);
+	TEST_ASSERT(nanvix_rcache_select_readahead(RMEM_CACHE_READAHEAD_MAX) == 0);
+	nanvix_rcache_clean();
+
+	rcache_scan(numbers, NUM_BLOCKS, 1);
+	rcache_scan(numbers, NUM_BLOCKS, 7);
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_BYPASS) == 0);
+	nanvix_rcache_clean();
+
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rcache_free(numbers[i]) == 0);
+}
+
+/*============================================================================*
+ * Benchmark: Readahead                                                       *
+ *============================================================================*/
+
+#if __BENCHMARK_READAHEAD
+
+/**
+ * @brief Benchmark: Readahead
+ *
+ * Compares sequential scans with and without readahead.
+ */
+static void test_rmem_rcache_readahead_latency(void)
+{
+	static unsigned buffer[RMEM_BLOCK_SIZE/sizeof(unsigned)];
+	static rpage_t numbers[NUM_BLOCKS];
+
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+	{
+		TEST_ASSERT((numbers[i] = nanvix_rcache_alloc()) != RMEM_NULL);
+
+		for (unsigned j = 0; j < RMEM_BLOCK_SIZE/sizeof(unsigned); j++)
+			buffer[j] = i*RMEM_NUM_BLOCKS + j;
+		TEST_ASSERT(nanvix_rmem_write(numbers[i], buffer) == RMEM_BLOCK_SIZE);
+	}
+
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_LRU) == 0);
+
+	for (int nlines = 0; nlines <= RMEM_CACHE_READAHEAD_MAX; nlines = (nlines == 0) ? 1 : 2*nlines)
+	{
+		uint64_t t0, t1;
+		unsigned nhits0, nmisses0;
+		unsigned nhits1, nmisses1;
+
+		TEST_ASSERT(nanvix_rcache_select_readahead(nlines) == 0);
+		nanvix_rcache_clean();
+
+		nanvix_rcache_stats(&nhits0, &nmisses0);
+		kclock(&t0);
+			rcache_scan(numbers, NUM_BLOCKS, 1);
+		kclock(&t1);
+		nanvix_rcache_stats(&nhits1, &nmisses1);
+
+		uprintf("[benchmark] readahead=%d lines scan=%d cycles hits=%d%%",
+			nlines,
+			(int) ((t1 - t0)/NUM_BLOCKS),
+			(int) (((nhits1 - nhits0)*100)/NUM_BLOCKS)
+		);
+	}
+
+	TEST_ASSERT(nanvix_rcache_select_readahead(RMEM_CACHE_READAHEAD_MAX) == 0);
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_BYPASS) == 0);
+	nanvix_rcache_clean();
+
+	for (unsigned i = 0; i < NUM_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rcache_free(numbers[i]) == 0);
+}
+
+#endif
+
+/*============================================================================*
+ * Benchmark: Replacement                                                     *
+ *============================================================================*/
+
+#if __BENCHMARK_REPLACEMENT
+
+/**
+ * @brief Number of pages touched by the replacement benchmark.
+ */
+#define NUM_TRACE_PAGES (4*RMEM_CACHE_SIZE)
+
+/**
+ * @brief Number of accesses in a trace.
+ */
+#define NUM_TRACE_ACCESSES (16*NUM_TRACE_PAGES)
+
+/**
+ * @name Access traces.
+ */
+/**@{*/
+#define TRACE_SEQUENTIAL 0 /**< Scans over all pages.                  */
+#define TRACE_LOOPING    1 /**< Loops slightly larger than the cache.  */
+#define TRACE_ZIPF       2 /**< Zipf-distributed accesses.             */
+#define TRACE_NUM        3 /**< Number of traces.                      */
+/**@}*/
+
+/**
+ * @brief Cumulative distribution of Zipf-distributed accesses.
+ */
+static unsigned zipf_cdf[NUM_TRACE_PAGES];
+
+/**
+ * @brief Initializes the distribution of Zipf-distributed accesses.
+ *
+ * The weight of the i-th page is proportional to 1/(i + 1).
+ */
+static void rcache_zipf_setup(void)
+{
+	unsigned sum = 0;
+
+	for (int i = 0; i < NUM_TRACE_PAGES; i++)
+		zipf_cdf[i] = (sum += 65536/(i + 1));
+}
+
+/**
+ * @brief Draws a Zipf-distributed page.
+ *
+ * @returns The index of the drawn page.
+ */
+static int rcache_zipf(void)
+{
+	int lo = 0;
+	int hi = NUM_TRACE_PAGES - 1;
+	unsigned r = urand() % zipf_cdf[NUM_TRACE_PAGES - 1];
+
+	while (lo < hi)
+	{
+		int mid = (lo + hi)/2;
+
+		if (zipf_cdf[mid] <= r)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return (lo);
+}
+
+/**
+ * @brief Gets the page of an access in a trace.
+ *
+ * @param trace Target trace.
+ * @param i     Number of the access.
+ *
+ * @returns The index of the accessed page.
+ */
+static int rcache_trace(int trace, int i)
+{
+	switch (trace)
+	{
+		case TRACE_SEQUENTIAL:
+			return (i % NUM_TRACE_PAGES);
+		case TRACE_LOOPING:
+			return (i % (RMEM_CACHE_SIZE + RMEM_CACHE_SIZE/4));
+		default:
+			return (rcache_zipf());
+	}
+}
+
+/**
+ * @brief Benchmark: Replacement
+ *
+ * Compares hit ratios of replacement policies on sequential, looping
+ * and Zipf-distributed traces.
+ */
+static void test_rmem_rcache_replacement(void)
+{
+	static rpage_t blks[NUM_TRACE_PAGES];
+	static const char *traces[TRACE_NUM] = { "sequential", "looping", "zipf" };
+	static const struct
+	{
+		int num;
+		const char *name;
+	} policies[] = {
+		{ RMEM_CACHE_FIFO,  "fifo"  },
+		{ RMEM_CACHE_LIFO,  "lifo"  },
+		{ RMEM_CACHE_NFU,   "nfu"   },
+		{ RMEM_CACHE_AGING, "aging" },
+		{ RMEM_CACHE_LRU,   "lru"   },
+		{ RMEM_CACHE_CLOCK, "clock" },
+		{ RMEM_CACHE_ARC,   "arc"   },
+	};
+
+	for (int i = 0; i < NUM_TRACE_PAGES; i++)
+		TEST_ASSERT((blks[i] = nanvix_rcache_alloc()) != RMEM_NULL);
+
+	rcache_zipf_setup();
+
+	for (int t = 0; t < TRACE_NUM; t++)
+	{
+		for (unsigned p = 0; p < sizeof(policies)/sizeof(policies[0]); p++)
+		{
+			uint64_t t0, t1;
+			unsigned nhits0, nmisses0;
+			unsigned nhits1, nmisses1;
+
+			TEST_ASSERT(nanvix_rcache_select_replacement_policy(policies[p].num) == 0);
+			nanvix_rcache_clean();
+
+			nanvix_rcache_stats(&nhits0, &nmisses0);
+			kclock(&t0);
+				for (int i = 0; i < NUM_TRACE_ACCESSES; i++)
+				{
+					rpage_t pgnum = blks[rcache_trace(t, i)];
+
+					TEST_ASSERT(nanvix_rcache_get(pgnum) != NULL);
+					TEST_ASSERT(nanvix_rcache_put(pgnum, 0) == 0);
+				}
+			kclock(&t1);
+			nanvix_rcache_stats(&nhits1, &nmisses1);
+
+			uprintf("[benchmark] trace=%s policy=%s ways=%d hits=%d%% access=%d cycles",
+				traces[t],
+				policies[p].name,
+				RMEM_CACHE_WAYS,
+				(int) (((nhits1 - nhits0)*100)/NUM_TRACE_ACCESSES),
+				(int) ((t1 - t0)/NUM_TRACE_ACCESSES)
+			);
+		}
+	}
+
+	/* Back to bypass mode. */
+	TEST_ASSERT(nanvix_rcache_select_replacement_policy(RMEM_CACHE_BYPASS) == 0);
+	nanvix_rcache_clean();
+
+	for (int i = 0; i < NUM_TRACE_PAGES; i++)
+		TEST_ASSERT(nanvix_rcache_free(blks[i]) == 0);
+}
+
+#endif
+
 /*============================================================================*
  * Test Driver Table                                                          *
  *============================================================================*/
@@ -108,5 +463,13 @@ static void test_rmem_rcache_consistency2(void)
 struct test tests_rmem_cache_stress[] = {
 	{ test_rmem_rcache_consistency,  "consistency       " },
 	{ test_rmem_rcache_consistency2, "consistency 2-step" },
+	{ test_rmem_rcache_dirty,        "dirty eviction    " },
+	{ test_rmem_rcache_readahead,    "readahead         " },
+#if __BENCHMARK_REPLACEMENT
+	{ test_rmem_rcache_replacement,  "replacement       " },
+#endif
+#if __BENCHMARK_READAHEAD
+	{ test_rmem_rcache_readahead_latency, "readahead latency " },
+#endif
 	{ NULL,                           NULL                },
 };
@@ -23,6 +23,7 @@
  */
 
 #define __NEED_MM_RMEM_STUB
+#define __NEED_RMEM_SERVER
 
 #include <nanvix/runtime/mm.h>
 #include <nanvix/ulib.h>
@@ -33,6 +34,11 @@
  */
 static char buffer[RMEM_BLOCK_SIZE];
 
+/**
+ * @brief Server statistics.
+ */
+static struct rmem_stats stats;
+
 /*============================================================================*
  * API Test: Alloc/Free                                                       *
  *============================================================================*/
@@ -122,6 +128,736 @@ static void test_rmem_stub_consistency(void)
 	TEST_ASSERT(nanvix_rmem_free(blknum3) == 0);
 }
 
+/*============================================================================*
+ * API Test: Vectored Read Write                                              *
+ *============================================================================*/
+
+/**
+ * @brief Number of blocks in vectored operations.
+ */
+#define NUM_BLOCKS_VECTOR 4
+
+/**
+ * @brief Buffers for vectored operations.
+ */
+static char buffers[NUM_BLOCKS_VECTOR][RMEM_BLOCK_SIZE];
+
+/**
+ * @brief API Test: Vectored Read Write
+ */
+static void test_rmem_stub_readv_writev(void)
+{
+	void *bufs[NUM_BLOCKS_VECTOR];
+	rpage_t blknums[NUM_BLOCKS_VECTOR];
+
+	for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+	{
+		TEST_ASSERT((blknums[i] = nanvix_rmem_alloc()) != RMEM_NULL);
+		bufs[i] = buffers[i];
+	}
+
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+			umemset(buffers[i], i + 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(
+			nanvix_rmem_writev(blknums, (const void * const *) bufs, NUM_BLOCKS_VECTOR) ==
+			NUM_BLOCKS_VECTOR*RMEM_BLOCK_SIZE
+		);
+
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+			umemset(buffers[i], 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(
+			nanvix_rmem_readv(blknums, bufs, NUM_BLOCKS_VECTOR) ==
+			NUM_BLOCKS_VECTOR*RMEM_BLOCK_SIZE
+		);
+
+		/* Checksum. */
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+		{
+			for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+				TEST_ASSERT(buffers[i][j] == (i + 1));
+		}
+
+		/* Blocks are also visible to scalar reads. */
+		TEST_ASSERT(nanvix_rmem_read(blknums[1], buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+			TEST_ASSERT(buffer[j] == 2);
+
+	for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+		TEST_ASSERT(nanvix_rmem_free(blknums[i]) == 0);
+}
+
+/*============================================================================*
+ * API Test: Alloc/Free Many                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Number of blocks in bulk allocations.
+ */
+#define NUM_BLOCKS_BULK 32
+
+/**
+ * @brief API Test: Alloc/Free Many
+ */
+static void test_rmem_stub_alloc_free_n(void)
+{
+	rpage_t blknums[NUM_BLOCKS_BULK];
+
+	TEST_ASSERT(nanvix_rmem_alloc_n(blknums, NUM_BLOCKS_BULK) == 0);
+
+		/* Blocks should be distinct. */
+		for (int i = 0; i < NUM_BLOCKS_BULK; i++)
+		{
+			TEST_ASSERT(blknums[i] != RMEM_NULL);
+			for (int j = i + 1; j < NUM_BLOCKS_BULK; j++)
+				TEST_ASSERT(blknums[i] != blknums[j]);
+		}
+
+		/* Blocks should be usable. */
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknums[NUM_BLOCKS_BULK - 1], buffer) == RMEM_BLOCK_SIZE);
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknums[NUM_BLOCKS_BULK - 1], buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 1);
+
+	TEST_ASSERT(nanvix_rmem_free_n(blknums, NUM_BLOCKS_BULK) == 0);
+}
+
+/*============================================================================*
+ * API Test: Partial Read/Write                                               *
+ *============================================================================*/
+
+/**
+ * @brief Offset of partial transfers.
+ */
+#define PARTIAL_OFFSET 100
+
+/**
+ * @brief Size of partial transfers.
+ */
+#define PARTIAL_SIZE 200
+
+/**
+ * @brief API Test: Partial Read/Write
+ */
+static void test_rmem_stub_read_write_partial(void)
+{
+	rpage_t blknum;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+
+		/* Overwrite a byte range. */
+		umemset(buffer, 2, PARTIAL_SIZE);
+		TEST_ASSERT(
+			nanvix_rmem_write_partial(
+				blknum,
+				buffer,
+				PARTIAL_OFFSET,
+				PARTIAL_SIZE
+			) == PARTIAL_SIZE
+		);
+
+		/* Read back the byte range. */
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(
+			nanvix_rmem_read_partial(
+				blknum,
+				buffer,
+				PARTIAL_OFFSET,
+				PARTIAL_SIZE
+			) == PARTIAL_SIZE
+		);
+		for (unsigned long i = 0; i < PARTIAL_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 2);
+
+		/* Bytes outside the range should be untouched. */
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+		{
+			if ((i >= PARTIAL_OFFSET) && (i < (PARTIAL_OFFSET + PARTIAL_SIZE)))
+				TEST_ASSERT(buffer[i] == 2);
+			else
+				TEST_ASSERT(buffer[i] == 1);
+		}
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Clone                                                            *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Clone
+ */
+static void test_rmem_stub_clone(void)
+{
+	rpage_t blknum;
+	rpage_t clone;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+
+		TEST_ASSERT((clone = nanvix_rmem_clone(blknum)) != RMEM_NULL);
+		TEST_ASSERT(clone != blknum);
+
+		/* Clone should see contents of the source block. */
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(clone, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 1);
+
+		/* Writes to the clone should not affect the source block. */
+		umemset(buffer, 2, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write_partial(clone, buffer, 0, PARTIAL_SIZE) == PARTIAL_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 1);
+
+		/* Clone should keep the contents it did not overwrite. */
+		TEST_ASSERT(nanvix_rmem_read(clone, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == ((i < PARTIAL_SIZE) ? 2 : 1));
+
+	TEST_ASSERT(nanvix_rmem_free(clone) == 0);
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Stats                                                            *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Stats
+ */
+static void test_rmem_stub_stats(void)
+{
+	int serverid;
+	rpage_t blknum;
+	uint32_t nreads0 = 0;
+	uint32_t nreads1 = 0;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+	serverid = RMEM_BLOCK_SERVER(blknum);
+
+		TEST_ASSERT(nanvix_rmem_stats(serverid, &stats) == 0);
+		for (int i = 0; i < RMEM_STATS_BUCKETS; i++)
+			nreads0 += stats.latencies[RMEM_READ][i];
+
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+
+		/* Read should have been accounted. */
+		TEST_ASSERT(nanvix_rmem_stats(serverid, &stats) == 0);
+		for (int i = 0; i < RMEM_STATS_BUCKETS; i++)
+			nreads1 += stats.latencies[RMEM_READ][i];
+		TEST_ASSERT(nreads1 == (nreads0 + 1));
+		TEST_ASSERT(stats.nbytes_out >= RMEM_BLOCK_SIZE);
+		TEST_ASSERT(stats.nblocks > 0);
+
+		/* Bad server. */
+		TEST_ASSERT(nanvix_rmem_stats(-1, &stats) < 0);
+		TEST_ASSERT(nanvix_rmem_stats(RMEM_SERVERS_NUM, &stats) < 0);
+		TEST_ASSERT(nanvix_rmem_stats(serverid, NULL) < 0);
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Free All                                                         *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Free All
+ *
+ * This releases every block owned by the calling process, so it only
+ * checks blocks that it allocates and it runs last.
+ */
+static void test_rmem_stub_free_all(void)
+{
+	rpage_t blknums[RMEM_IOV_MAX];
+
+	for (int i = 0; i < RMEM_IOV_MAX; i++)
+		TEST_ASSERT((blknums[i] = nanvix_rmem_alloc()) != RMEM_NULL);
+
+	TEST_ASSERT(nanvix_rmem_free_all() >= RMEM_IOV_MAX);
+
+	/* Blocks should be gone. */
+	for (int i = 0; i < RMEM_IOV_MAX; i++)
+		TEST_ASSERT(nanvix_rmem_free(blknums[i]) < 0);
+}
+
+/*============================================================================*
+ * API Test: Geometry                                                         *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Geometry
+ */
+static void test_rmem_stub_geometry(void)
+{
+	size_t blksize;
+	rpage_t nblocks;
+
+	for (int i = 0; i < RMEM_SERVERS_NUM; i++)
+	{
+		TEST_ASSERT(nanvix_rmem_geometry(i, &blksize, &nblocks) == 0);
+		TEST_ASSERT(blksize == RMEM_BLOCK_SIZE);
+		TEST_ASSERT((nblocks > 0) && (nblocks <= RMEM_NUM_BLOCKS));
+
+		/* Last block should be valid, but not allocated. */
+		TEST_ASSERT(nanvix_rmem_free(RMEM_BLOCK(i, nblocks - 1)) == -EFAULT);
+		TEST_ASSERT(nanvix_rmem_free(RMEM_BLOCK(i, nblocks)) == -EINVAL);
+	}
+
+	/* Bad server. */
+	TEST_ASSERT(nanvix_rmem_geometry(-1, &blksize, &nblocks) < 0);
+	TEST_ASSERT(nanvix_rmem_geometry(RMEM_SERVERS_NUM, &blksize, &nblocks) < 0);
+}
+
+/*============================================================================*
+ * API Test: Prefetch                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Number of blocks in the prefetch test.
+ */
+#define PREFETCH_NUM_BLOCKS 16
+
+/**
+ * @brief API Test: Prefetch
+ */
+static void test_rmem_stub_prefetch(void)
+{
+	int ret;
+	rpage_t blknums[PREFETCH_NUM_BLOCKS];
+
+	/* Not supported by this transport. */
+	if ((ret = nanvix_rmem_prefetch(RMEM_PREFETCH_MAX)) == -ENOTSUP)
+		return;
+	TEST_ASSERT(ret == 0);
+
+	for (int i = 0; i < PREFETCH_NUM_BLOCKS; i++)
+	{
+		TEST_ASSERT((blknums[i] = nanvix_rmem_alloc()) != RMEM_NULL);
+		umemset(buffer, i + 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknums[i], buffer) == RMEM_BLOCK_SIZE);
+	}
+
+	/* Pushed blocks should have the right contents. */
+	for (int i = 0; i < PREFETCH_NUM_BLOCKS; i++)
+	{
+		TEST_ASSERT(nanvix_rmem_read(blknums[i], buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+			TEST_ASSERT(buffer[j] == (i + 1));
+
+		/* Writes should not be shadowed by pushed blocks. */
+		if (i == (PREFETCH_NUM_BLOCKS/2))
+		{
+			umemset(buffer, 0, RMEM_BLOCK_SIZE);
+			for (int k = i + 1; k < PREFETCH_NUM_BLOCKS; k++)
+				TEST_ASSERT(nanvix_rmem_write_partial(blknums[k], buffer, 0, PARTIAL_SIZE) == PARTIAL_SIZE);
+			for (int k = i + 1; k < PREFETCH_NUM_BLOCKS; k++)
+			{
+				TEST_ASSERT(nanvix_rmem_read(blknums[k], buffer) == RMEM_BLOCK_SIZE);
+				TEST_ASSERT(buffer[0] == 0);
+				TEST_ASSERT(buffer[RMEM_BLOCK_SIZE - 1] == (k + 1));
+			}
+			break;
+		}
+	}
+
+	TEST_ASSERT(nanvix_rmem_prefetch(0) == 0);
+
+	for (int i = 0; i < PREFETCH_NUM_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rmem_free(blknums[i]) == 0);
+}
+
+/*============================================================================*
+ * API Test: Zero Block                                                       *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Zero Block
+ */
+static void test_rmem_stub_zero(void)
+{
+	rpage_t blknum;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		/* Fresh block should read as zeros. */
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 0);
+
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read_partial(blknum, buffer, PARTIAL_OFFSET, PARTIAL_SIZE) == PARTIAL_SIZE);
+		for (unsigned long i = 0; i < PARTIAL_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 0);
+
+		/* Zero blocks should overwrite previous contents. */
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 0);
+
+		/* Block should still be writable. */
+		umemset(buffer, 2, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write_partial(blknum, buffer, PARTIAL_OFFSET, PARTIAL_SIZE) == PARTIAL_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+		{
+			TEST_ASSERT(buffer[i] ==
+				(((i >= PARTIAL_OFFSET) && (i < (PARTIAL_OFFSET + PARTIAL_SIZE))) ? 2 : 0)
+			);
+		}
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Migrate                                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Migrate
+ */
+static void test_rmem_stub_migrate(void)
+{
+	rpage_t blknum;
+	int serverid;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+
+		/* Move block around all servers. */
+		for (int i = 1; i <= RMEM_SERVERS_NUM; i++)
+		{
+			serverid = (RMEM_BLOCK_SERVER(blknum) + i) % RMEM_SERVERS_NUM;
+			TEST_ASSERT(nanvix_rmem_migrate(blknum, serverid) == 0);
+
+			/* Contents should follow the block. */
+			umemset(buffer, 0, RMEM_BLOCK_SIZE);
+			TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+			for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+				TEST_ASSERT(buffer[j] == 1);
+		}
+
+		/* Block should still be writable. */
+		umemset(buffer, 2, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknum, buffer) == RMEM_BLOCK_SIZE);
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+			TEST_ASSERT(buffer[j] == 2);
+
+		/* Rebalancing should not fail. */
+		TEST_ASSERT(nanvix_rmem_rebalance(&blknum, 1) >= 0);
+
+		/* Bad server. */
+		TEST_ASSERT(nanvix_rmem_migrate(blknum, RMEM_SERVERS_NUM) < 0);
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Posted Write                                                     *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Posted Write
+ */
+static void test_rmem_stub_posted(void)
+{
+	rpage_t blknum;
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		umemset(buffer, 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write_posted(blknum, buffer) == RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_fence() == 0);
+
+		/* Posted writes should be applied in order. */
+		umemset(buffer, 2, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write_posted(blknum, buffer) == RMEM_BLOCK_SIZE);
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		for (unsigned long i = 0; i < RMEM_BLOCK_SIZE; i++)
+			TEST_ASSERT(buffer[i] == 2);
+		TEST_ASSERT(nanvix_rmem_fence() == 0);
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+
+	/* Errors should be reported by the fence. */
+	umemset(buffer, 1, RMEM_BLOCK_SIZE);
+	TEST_ASSERT(nanvix_rmem_write_posted(blknum, buffer) == RMEM_BLOCK_SIZE);
+	TEST_ASSERT(nanvix_rmem_fence() < 0);
+	TEST_ASSERT(nanvix_rmem_fence() == 0);
+}
+
+/*============================================================================*
+ * API Test: Atomic Operations                                                *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Atomic Operations
+ */
+static void test_rmem_stub_atomic(void)
+{
+	rpage_t blknum;
+	uint64_t old;
+	const size_t offset = 8*sizeof(uint64_t);
+
+	TEST_ASSERT((blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		TEST_ASSERT(nanvix_rmem_fetch_add(blknum, offset, 5, &old) == 0);
+		TEST_ASSERT(old == 0);
+		TEST_ASSERT(nanvix_rmem_fetch_add(blknum, offset, 3, &old) == 0);
+		TEST_ASSERT(old == 5);
+
+		/* Failed compare-and-swap. */
+		TEST_ASSERT(nanvix_rmem_compare_swap(blknum, offset, 0, 1, &old) == 0);
+		TEST_ASSERT(old == 8);
+
+		TEST_ASSERT(nanvix_rmem_compare_swap(blknum, offset, 8, 1, &old) == 0);
+		TEST_ASSERT(old == 8);
+		TEST_ASSERT(nanvix_rmem_fetch_or(blknum, offset, 6, &old) == 0);
+		TEST_ASSERT(old == 1);
+		TEST_ASSERT(nanvix_rmem_swap(blknum, offset, 42, &old) == 0);
+		TEST_ASSERT(old == 7);
+
+		/* Atomic operations should be seen by reads. */
+		TEST_ASSERT(nanvix_rmem_read(blknum, buffer) == RMEM_BLOCK_SIZE);
+		umemcpy(&old, &buffer[offset], sizeof(uint64_t));
+		TEST_ASSERT(old == 42);
+		umemcpy(&old, &buffer[0], sizeof(uint64_t));
+		TEST_ASSERT(old == 0);
+
+		/* Bad words. */
+		TEST_ASSERT(nanvix_rmem_swap(blknum, offset + 1, 0, NULL) < 0);
+		TEST_ASSERT(nanvix_rmem_swap(blknum, RMEM_BLOCK_SIZE, 0, NULL) < 0);
+
+	TEST_ASSERT(nanvix_rmem_free(blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Checkpoint                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Block that is looked for by checkpoint sinks.
+ */
+static rpage_t checkpoint_blknum = RMEM_NULL;
+
+/**
+ * @brief Checkpoint sink that looks for a block.
+ */
+static int test_rmem_stub_checkpoint_sink(rpage_t blknum, rpage_t owner, const void *data, void *arg)
+{
+	if (blknum == checkpoint_blknum)
+	{
+		TEST_ASSERT(owner != RMEM_RECORD_FREE);
+		TEST_ASSERT(((const char *) data)[0] == 3);
+		*((int *) arg) = 1;
+	}
+
+	return (0);
+}
+
+/**
+ * @brief Checkpoint source that yields a single block.
+ */
+static int test_rmem_stub_checkpoint_source(rpage_t *blknum, rpage_t *owner, void *data, void *arg)
+{
+	/* No more records. */
+	if (*((int *) arg))
+		return (0);
+
+	*((int *) arg) = 1;
+	*blknum = checkpoint_blknum;
+	*owner = 0;
+	umemset(data, 0, RMEM_BLOCK_SIZE);
+
+	return (1);
+}
+
+/**
+ * @brief API Test: Checkpoint
+ */
+static void test_rmem_stub_checkpoint(void)
+{
+	int ret;
+	int found = 0;
+	int serverid;
+
+	TEST_ASSERT((checkpoint_blknum = nanvix_rmem_alloc()) != RMEM_NULL);
+	serverid = RMEM_BLOCK_SERVER(checkpoint_blknum);
+
+		umemset(buffer, 3, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(checkpoint_blknum, buffer) == RMEM_BLOCK_SIZE);
+
+		/* Not supported by this transport. */
+		if ((ret = nanvix_rmem_checkpoint(serverid, test_rmem_stub_checkpoint_sink, &found)) != -ENOTSUP)
+		{
+			TEST_ASSERT(ret == 0);
+			TEST_ASSERT(found);
+
+			/* Checkpoints should be incremental. */
+			found = 0;
+			TEST_ASSERT(nanvix_rmem_checkpoint(serverid, test_rmem_stub_checkpoint_sink, &found) == 0);
+			TEST_ASSERT(!found);
+
+			/* Live servers should not be restored. */
+			TEST_ASSERT(nanvix_rmem_restore(serverid, test_rmem_stub_checkpoint_source, &found) == -EBUSY);
+		}
+
+	TEST_ASSERT(nanvix_rmem_free(checkpoint_blknum) == 0);
+}
+
+/*============================================================================*
+ * API Test: Asynchronous Read/Write                                          *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Asynchronous Read/Write
+ */
+static void test_rmem_stub_async(void)
+{
+	int tags[NUM_BLOCKS_VECTOR];
+	rpage_t blknums[NUM_BLOCKS_VECTOR];
+
+	TEST_ASSERT(nanvix_rmem_alloc_n(blknums, NUM_BLOCKS_VECTOR) == 0);
+
+		/* Many writes in flight. */
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+		{
+			umemset(buffers[i], i + 1, RMEM_BLOCK_SIZE);
+			TEST_ASSERT((tags[i] = nanvix_rmem_write_async(blknums[i], buffers[i])) > 0);
+		}
+		for (int i = NUM_BLOCKS_VECTOR - 1; i >= 0; i--)
+			TEST_ASSERT(nanvix_rmem_wait(tags[i]) == 0);
+
+		/* Many reads in flight. */
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+		{
+			umemset(buffers[i], 0, RMEM_BLOCK_SIZE);
+			TEST_ASSERT((tags[i] = nanvix_rmem_read_async(blknums[i], buffers[i])) > 0);
+		}
+
+		/* Synchronous requests should not steal replies. */
+		TEST_ASSERT(nanvix_rmem_read(blknums[0], buffer) == RMEM_BLOCK_SIZE);
+		TEST_ASSERT(buffer[0] == 1);
+
+		for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+		{
+			TEST_ASSERT(nanvix_rmem_poll(tags[i]) >= 0);
+			TEST_ASSERT(nanvix_rmem_wait(tags[i]) == 0);
+			for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+				TEST_ASSERT(buffers[i][j] == (i + 1));
+		}
+
+		/* Tags are released by waits. */
+		TEST_ASSERT(nanvix_rmem_wait(tags[0]) == -EINVAL);
+		TEST_ASSERT(nanvix_rmem_poll(tags[0]) == -EINVAL);
+
+	TEST_ASSERT(nanvix_rmem_free_n(blknums, NUM_BLOCKS_VECTOR) == 0);
+}
+
+/*============================================================================*
+ * API Test: Asynchronous Read Across Vectored Read                           *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Asynchronous Read Across Vectored Read
+ *
+ * Strided asynchronous reads to a server get blocks pushed ahead of
+ * them, while vectored reads to another server are issued.
+ */
+static void test_rmem_stub_async_readv(void)
+{
+	int ret;
+	int tag;
+	int serverid;
+	void *bufs[NUM_BLOCKS_VECTOR];
+	rpage_t blknums[NUM_BLOCKS_VECTOR];
+	rpage_t strided[PREFETCH_NUM_BLOCKS];
+
+	/* A second server is needed. */
+	if (RMEM_SERVERS_NUM < 2)
+		return;
+
+	/* Not supported by this transport. */
+	if ((ret = nanvix_rmem_prefetch(RMEM_PREFETCH_MAX)) == -ENOTSUP)
+		return;
+	TEST_ASSERT(ret == 0);
+
+	TEST_ASSERT(nanvix_rmem_alloc_n(blknums, NUM_BLOCKS_VECTOR) == 0);
+	for (int i = 0; i < NUM_BLOCKS_VECTOR; i++)
+	{
+		bufs[i] = buffers[i];
+		umemset(buffers[i], i + 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(blknums[i], buffers[i]) == RMEM_BLOCK_SIZE);
+	}
+
+	/* Strided blocks live in another server. */
+	serverid = (RMEM_BLOCK_SERVER(blknums[0]) + 1) % RMEM_SERVERS_NUM;
+	TEST_ASSERT(nanvix_rmem_alloc_n(strided, PREFETCH_NUM_BLOCKS) == 0);
+	for (int i = 0; i < PREFETCH_NUM_BLOCKS; i++)
+	{
+		if ((int) RMEM_BLOCK_SERVER(strided[i]) != serverid)
+			TEST_ASSERT(nanvix_rmem_migrate(strided[i], serverid) == 0);
+
+		umemset(buffer, NUM_BLOCKS_VECTOR + i + 1, RMEM_BLOCK_SIZE);
+		TEST_ASSERT(nanvix_rmem_write(strided[i], buffer) == RMEM_BLOCK_SIZE);
+	}
+
+	/* Set up a stride. */
+	TEST_ASSERT(nanvix_rmem_read(strided[0], buffer) == RMEM_BLOCK_SIZE);
+	TEST_ASSERT(nanvix_rmem_read(strided[1], buffer) == RMEM_BLOCK_SIZE);
+
+	for (int i = 2; i < PREFETCH_NUM_BLOCKS; i++)
+	{
+		umemset(buffer, 0, RMEM_BLOCK_SIZE);
+		TEST_ASSERT((tag = nanvix_rmem_read_async(strided[i], buffer)) > 0);
+
+			/* Vectored read with the asynchronous read in flight. */
+			for (int k = 0; k < NUM_BLOCKS_VECTOR; k++)
+				umemset(buffers[k], 0, RMEM_BLOCK_SIZE);
+			TEST_ASSERT(
+				nanvix_rmem_readv(blknums, bufs, NUM_BLOCKS_VECTOR) ==
+				NUM_BLOCKS_VECTOR*RMEM_BLOCK_SIZE
+			);
+
+		TEST_ASSERT(nanvix_rmem_wait(tag) == 0);
+
+		/* Checksum. */
+		for (int k = 0; k < NUM_BLOCKS_VECTOR; k++)
+		{
+			for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+				TEST_ASSERT(buffers[k][j] == (k + 1));
+		}
+		for (unsigned long j = 0; j < RMEM_BLOCK_SIZE; j++)
+			TEST_ASSERT(buffer[j] == (NUM_BLOCKS_VECTOR + i + 1));
+	}
+
+	TEST_ASSERT(nanvix_rmem_prefetch(0) == 0);
+
+	TEST_ASSERT(nanvix_rmem_free_n(strided, PREFETCH_NUM_BLOCKS) == 0);
+	TEST_ASSERT(nanvix_rmem_free_n(blknums, NUM_BLOCKS_VECTOR) == 0);
+}
+
 /*============================================================================*
  * Test Driver Table                                                          *
  *============================================================================*/
@@ -130,8 +866,23 @@ static void test_rmem_stub_consistency(void)
  * @brief Unit tests.
  */
 struct test tests_rmem_stub_api[] = {
-	{ test_rmem_stub_alloc_free, "alloc/free"   },
-	{ test_rmem_stub_read_write, "read/write"   },
-	{ test_rmem_stub_consistency, "consistency" },
-	{ NULL,                       NULL          },
+	{ test_rmem_stub_alloc_free,         "alloc/free"         },
+	{ test_rmem_stub_read_write,         "read/write"         },
+	{ test_rmem_stub_consistency,        "consistency"        },
+	{ test_rmem_stub_readv_writev,       "readv/writev"       },
+	{ test_rmem_stub_alloc_free_n,       "alloc/free n"       },
+	{ test_rmem_stub_read_write_partial, "read/write partial" },
+	{ test_rmem_stub_clone,              "clone"              },
+	{ test_rmem_stub_stats,              "stats"              },
+	{ test_rmem_stub_geometry,           "geometry"           },
+	{ test_rmem_stub_prefetch,           "prefetch"           },
+	{ test_rmem_stub_zero,               "zero block"         },
+	{ test_rmem_stub_migrate,            "migrate"            },
+	{ test_rmem_stub_posted,             "posted write"       },
+	{ test_rmem_stub_atomic,             "atomic"             },
+	{ test_rmem_stub_checkpoint,         "checkpoint"         },
+	{ test_rmem_stub_async,              "async read/write"   },
+	{ test_rmem_stub_async_readv,        "async readv"        },
+	{ test_rmem_stub_free_all,           "free all"           },
+	{ NULL,                              NULL                 },
 };
@@ -25,6 +25,7 @@
 #define __NEED_MM_RMEM_STUB
 
 #include <nanvix/runtime/mm.h>
+#include <nanvix/sys/perf.h>
 #include <nanvix/ulib.h>
 #include "../../test.h"
 
@@ -43,6 +44,16 @@
  */
 #define __TEST_READ_WRITE_ALL 0
 
+/**
+ * @brief Run allocation latency benchmark?
+ */
+#define __BENCHMARK_ALLOC_LATENCY 0
+
+/**
+ * @brief Run prefetch benchmark?
+ */
+#define __BENCHMARK_PREFETCH 0
+
 /**
  * @brief Number of blocks to allocate.
  */
@@ -402,6 +413,133 @@ static void test_rmem_stub_consistency2(void)
 	}
 }
 
+/*============================================================================*
+ * Benchmark: Alloc Latency                                                   *
+ *============================================================================*/
+
+#if __BENCHMARK_ALLOC_LATENCY
+
+/**
+ * @brief Number of occupancy levels in the allocation benchmark.
+ */
+#define NUM_OCCUPANCY_LEVELS 10
+
+/**
+ * @brief Number of samples per occupancy level.
+ */
+#define NUM_SAMPLES 16
+
+/**
+ * @brief Benchmark: Alloc Latency
+ *
+ * Measures the latency of allocations as remote memory fills up.
+ */
+static void test_rmem_stub_alloc_latency(void)
+{
+	unsigned long n = 0;
+	static rpage_t blks[RMEM_SERVERS_NUM*RMEM_NUM_BLOCKS];
+	const unsigned long capacity = RMEM_SERVERS_NUM*(RMEM_NUM_BLOCKS - 1);
+
+	for (unsigned long level = 0; level < NUM_OCCUPANCY_LEVELS; level++)
+	{
+		uint64_t t0, t1;
+		uint64_t total = 0;
+		unsigned long target;
+
+		/* Fill up remote memory. */
+		target = (capacity*level)/NUM_OCCUPANCY_LEVELS;
+		while (n < target)
+			TEST_ASSERT((blks[n++] = nanvix_rmem_alloc()) != RMEM_NULL);
+
+		/* Sample. */
+		for (unsigned long i = 0; i < NUM_SAMPLES; i++)
+		{
+			kclock(&t0);
+				TEST_ASSERT((blks[n++] = nanvix_rmem_alloc()) != RMEM_NULL);
+			kclock(&t1);
+			total += (t1 - t0);
+		}
+
+		uprintf("[benchmark] occupancy=%d%% alloc=%d cycles",
+			(int) ((n*100)/capacity),
+			(int) (total/NUM_SAMPLES)
+		);
+	}
+
+	/* Free all blocks. */
+	while (n > 0)
+		TEST_ASSERT(nanvix_rmem_free(blks[--n]) == 0);
+}
+
+#endif
+
+/*============================================================================*
+ * Benchmark: Prefetch                                                        *
+ *============================================================================*/
+
+#if __BENCHMARK_PREFETCH
+
+/**
+ * @brief Scans blocks in ascending order.
+ *
+ * @param blks Target blocks.
+ *
+ * @returns The number of cycles spent in the scan.
+ */
+static uint64_t rmem_stub_scan(const rpage_t *blks)
+{
+	uint64_t t0, t1;
+
+	kclock(&t0);
+		for (unsigned long i = 0; i < NUM_BLOCKS; i++)
+			TEST_ASSERT(nanvix_rmem_read(blks[i], buffer1) == RMEM_BLOCK_SIZE);
+	kclock(&t1);
+
+	return (t1 - t0);
+}
+
+/**
+ * @brief Benchmark: Prefetch
+ *
+ * Compares sequential scans with and without server-side prefetching.
+ */
+static void test_rmem_stub_prefetch(void)
+{
+	uint64_t t0, t1;
+	unsigned npushed0, nhits0;
+	unsigned npushed1, nhits1;
+	rpage_t blks[NUM_BLOCKS];
+
+	/* Allocate many blocks.*/
+	for (unsigned long i = 0; i < NUM_BLOCKS; i++)
+		TEST_ASSERT((blks[i] = nanvix_rmem_alloc()) != RMEM_NULL);
+
+	/* Without prefetching. */
+	t0 = rmem_stub_scan(blks);
+
+	/* With prefetching. */
+	nanvix_rmem_prefetch_stats(&npushed0, &nhits0);
+	TEST_ASSERT(nanvix_rmem_prefetch(RMEM_PREFETCH_MAX) == 0);
+		t1 = rmem_stub_scan(blks);
+	TEST_ASSERT(nanvix_rmem_prefetch(0) == 0);
+	nanvix_rmem_prefetch_stats(&npushed1, &nhits1);
+
+	uprintf("[benchmark] scan=%d cycles prefetch=%d cycles pushed=%d hits=%d (%d%%)",
+		(int) (t0/NUM_BLOCKS),
+		(int) (t1/NUM_BLOCKS),
+		npushed1 - npushed0,
+		nhits1 - nhits0,
+		(npushed1 == npushed0) ? 0 :
+			(int) (((nhits1 - nhits0)*100)/(npushed1 - npushed0))
+	);
+
+	/* Free all blocks. */
+	for (unsigned long i = 0; i < NUM_BLOCKS; i++)
+		TEST_ASSERT(nanvix_rmem_free(blks[i]) == 0);
+}
+
+#endif
+
 /*============================================================================*
  * Test Driver Table                                                          *
  *============================================================================*/
@@ -423,6 +561,12 @@ struct test tests_rmem_stub_stress[] = {
 	{ test_rmem_stub_read_write_interleaved, "read/write interleaved" },
 #if __TEST_READ_WRITE_ALL
 	{ test_rmem_stub_read_write_all,         "read/write all        " },
+#endif
+#if __BENCHMARK_ALLOC_LATENCY
+	{ test_rmem_stub_alloc_latency,          "alloc latency         " },
+#endif
+#if __BENCHMARK_PREFETCH
+	{ test_rmem_stub_prefetch,               "prefetch              " },
 #endif
 	{ NULL,                                   NULL                    },
 };